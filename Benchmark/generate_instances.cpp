@@ -0,0 +1,121 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <set>
+#include <random>
+#include <cstdlib>
+#include <cmath>
+
+// Instances are written as DIMACS CNF on stdout. Random choices come straight from std::mt19937,
+// whose output sequence is fixed by the standard, so a seed gives the same file on every platform.
+
+void printUsage(const char* program) {
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << "  " << program << " ksat <k> <vars> <clause/var ratio> <seed>" << std::endl;
+    std::cerr << "  " << program << " php <pigeons> [holes]   (holes defaults to pigeons - 1, unsatisfiable)" << std::endl;
+    std::cerr << "  " << program << " coloring <colors> <vertices> <edges> <seed>" << std::endl;
+}
+
+void printFormula(const std::string& comment, int numVars, const std::vector<std::vector<int>>& clauses) {
+    std::cout << "c " << comment << std::endl;
+    std::cout << "p cnf " << numVars << " " << clauses.size() << std::endl;
+    for (const auto& clause : clauses) {
+        for (int lit : clause) std::cout << lit << " ";
+        std::cout << "0" << std::endl;
+    }
+}
+
+// Uniform random k-SAT: every clause has k distinct variables with random signs
+std::vector<std::vector<int>> randomKSat(int k, int numVars, double ratio, unsigned seed) {
+    std::mt19937 rng(seed);
+    int numClauses = static_cast<int>(std::lround(ratio * numVars));
+    std::vector<std::vector<int>> clauses;
+    for (int i = 0; i < numClauses; ++i) {
+        std::vector<int> clause;
+        while (static_cast<int>(clause.size()) < k) {
+            int var = static_cast<int>(rng() % numVars) + 1;
+            bool duplicate = false;
+            for (int lit : clause) duplicate = duplicate || std::abs(lit) == var;
+            if (!duplicate) clause.push_back((rng() & 1) ? var : -var);
+        }
+        clauses.push_back(clause);
+    }
+    return clauses;
+}
+
+// Pigeonhole: variable p * holes + h + 1 puts pigeon p in hole h
+std::vector<std::vector<int>> pigeonhole(int pigeons, int holes) {
+    std::vector<std::vector<int>> clauses;
+    for (int p = 0; p < pigeons; ++p) {
+        std::vector<int> clause;
+        for (int h = 0; h < holes; ++h) clause.push_back(p * holes + h + 1);
+        clauses.push_back(clause);
+    }
+    for (int h = 0; h < holes; ++h) {
+        for (int p = 0; p < pigeons; ++p) {
+            for (int q = p + 1; q < pigeons; ++q) clauses.push_back({-(p * holes + h + 1), -(q * holes + h + 1)});
+        }
+    }
+    return clauses;
+}
+
+// k-coloring of a random graph with the given number of distinct edges, in the same encoding as
+// the 3-coloring cases of test_cases.txt: variable v * colors + c + 1 gives vertex v color c
+std::vector<std::vector<int>> graphColoring(int colors, int vertices, int edges, unsigned seed) {
+    std::mt19937 rng(seed);
+    auto var = [&](int v, int c) { return v * colors + c + 1; };
+    std::vector<std::vector<int>> clauses;
+    for (int v = 0; v < vertices; ++v) {
+        std::vector<int> clause;
+        for (int c = 0; c < colors; ++c) clause.push_back(var(v, c));
+        clauses.push_back(clause);
+        for (int c = 0; c < colors; ++c) {
+            for (int d = c + 1; d < colors; ++d) clauses.push_back({-var(v, c), -var(v, d)});
+        }
+    }
+    std::set<std::pair<int, int>> graph;
+    while (static_cast<int>(graph.size()) < edges) {
+        int u = static_cast<int>(rng() % vertices);
+        int v = static_cast<int>(rng() % vertices);
+        if (u == v) continue;
+        if (!graph.insert({std::min(u, v), std::max(u, v)}).second) continue;
+        for (int c = 0; c < colors; ++c) clauses.push_back({-var(u, c), -var(v, c)});
+    }
+    return clauses;
+}
+
+int main(int argc, char* argv[]) {
+    std::string kind = argc > 1 ? argv[1] : "";
+    std::string comment = "generate_instances";
+    for (int i = 1; i < argc; ++i) comment += " " + std::string(argv[i]);
+    if (kind == "ksat" && argc == 6) {
+        int k = std::atoi(argv[2]);
+        int numVars = std::atoi(argv[3]);
+        if (k < 1 || numVars < k) {
+            std::cerr << "Need 1 <= k <= vars" << std::endl;
+            return 1;
+        }
+        printFormula(comment, numVars, randomKSat(k, numVars, std::atof(argv[4]), std::strtoul(argv[5], nullptr, 10)));
+    } else if (kind == "php" && (argc == 3 || argc == 4)) {
+        int pigeons = std::atoi(argv[2]);
+        int holes = argc == 4 ? std::atoi(argv[3]) : pigeons - 1;
+        if (pigeons < 1 || holes < 1) {
+            std::cerr << "Need at least one pigeon and one hole" << std::endl;
+            return 1;
+        }
+        printFormula(comment, pigeons * holes, pigeonhole(pigeons, holes));
+    } else if (kind == "coloring" && argc == 6) {
+        int colors = std::atoi(argv[2]);
+        int vertices = std::atoi(argv[3]);
+        int edges = std::atoi(argv[4]);
+        if (colors < 1 || vertices < 2 || edges < 0 || edges > vertices * (vertices - 1) / 2) {
+            std::cerr << "Need at least one color, two vertices and at most vertices*(vertices-1)/2 edges" << std::endl;
+            return 1;
+        }
+        printFormula(comment, colors * vertices, graphColoring(colors, vertices, edges, std::strtoul(argv[5], nullptr, 10)));
+    } else {
+        printUsage(argv[0]);
+        return 1;
+    }
+    return 0;
+}
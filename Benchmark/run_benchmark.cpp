@@ -0,0 +1,223 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "../Core/json.h"
+
+// Runs every solver on every instance a number of times and reports one row per run. Solvers are
+// started as child processes, so peak RSS comes from the kernel's accounting of that child alone.
+
+struct SolverCommand {
+    std::string name;
+    std::vector<std::string> argv;  // executable followed by its own options; the instance is appended
+};
+
+struct RunResult {
+    std::string solver;
+    std::string instance;
+    int repetition = 0;
+    std::string result;        // SAT, UNSAT, TIMEOUT or ERROR
+    double wallSeconds = 0.0;  // whole process, parsing included
+    double solveSeconds = -1;  // "Solving time" as reported by the solver, -1 if absent
+    long long decisions = -1;
+    long long propagations = -1;
+    long peakRssKb = 0;
+};
+
+static const char* DEFAULT_SOLVERS[] = {"Resolution", "DP", "DPLL_w_stepcount", "DPLL_random",
+                                        "DPLL_static_w_stepcount", "DPLL_dynamic_w_stepcount"};
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--repeat N] [--timeout SECONDS] [--format csv|json] [--output FILE]" << std::endl;
+    std::cerr << "       [--root DIR] [--solver \"NAME=PATH [ARGS...]\"]... INSTANCE..." << std::endl;
+    std::cerr << "Without --solver, runs DIR/<solver directory>/solver for the six original solvers." << std::endl;
+}
+
+bool parseSolver(const std::string& spec, SolverCommand& command) {
+    size_t eq = spec.find('=');
+    if (eq == std::string::npos || eq == 0) return false;
+    command.name = spec.substr(0, eq);
+    std::istringstream words(spec.substr(eq + 1));
+    std::string word;
+    while (words >> word) command.argv.push_back(word);
+    return !command.argv.empty();
+}
+
+long long reportedCount(const std::string& output, const std::string& label) {
+    size_t pos = output.find(label + ": ");
+    return pos == std::string::npos ? -1 : std::atoll(output.c_str() + pos + label.size() + 2);
+}
+
+RunResult runOnce(const SolverCommand& command, const std::string& instance, double timeout) {
+    RunResult run;
+    run.solver = command.name;
+    run.instance = instance;
+    char outputPath[] = "/tmp/run_benchmark_XXXXXX";
+    int outputFd = mkstemp(outputPath);
+    if (outputFd < 0) {
+        run.result = "ERROR";
+        return run;
+    }
+    std::vector<char*> argv;
+    for (const std::string& arg : command.argv) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(const_cast<char*>(instance.c_str()));
+    argv.push_back(nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(outputFd, STDOUT_FILENO);
+        int devNull = open("/dev/null", O_RDWR);
+        dup2(devNull, STDIN_FILENO);
+        dup2(devNull, STDERR_FILENO);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+    close(outputFd);
+    int status = 0;
+    struct rusage usage;
+    bool timedOut = false;
+    while (true) {
+        pid_t done = wait4(pid, &status, WNOHANG, &usage);
+        if (done == pid || done < 0) break;
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > timeout) {
+            kill(pid, SIGKILL);
+            wait4(pid, &status, 0, &usage);
+            timedOut = true;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    run.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#ifdef __APPLE__
+    run.peakRssKb = usage.ru_maxrss / 1024;
+#else
+    run.peakRssKb = usage.ru_maxrss;
+#endif
+
+    std::ifstream file(outputPath);
+    std::string output((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    unlink(outputPath);
+    std::string firstLine = output.substr(0, output.find('\n'));
+    if (timedOut) {
+        run.result = "TIMEOUT";
+    } else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        run.result = "ERROR";
+    } else if (firstLine == "Unsatisfiable") {
+        run.result = "UNSAT";
+    } else if (firstLine == "Satisfiable" || firstLine == "Resolution did not derive empty clause") {
+        run.result = "SAT";  // saturation without the empty clause means satisfiable
+    } else {
+        run.result = "ERROR";
+    }
+    size_t time = output.find("Solving time: ");
+    if (time != std::string::npos) run.solveSeconds = std::atof(output.c_str() + time + 14);
+    run.decisions = reportedCount(output, "Decision Steps");
+    run.propagations = reportedCount(output, "Propagation Steps");
+    return run;
+}
+
+std::string csvField(const std::string& value) {
+    if (value.find_first_of(",\"\n") == std::string::npos) return value;
+    std::string quoted = "\"";
+    for (char c : value) quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+    return quoted + "\"";
+}
+
+void writeReport(std::ostream& out, const std::vector<RunResult>& runs, bool json) {
+    if (!json) {
+        out << "solver,instance,repetition,result,wall_seconds,solve_seconds,decisions,propagations,peak_rss_kb\n";
+        for (const RunResult& run : runs) {
+            out << csvField(run.solver) << "," << csvField(run.instance) << "," << run.repetition << ","
+                << run.result << "," << run.wallSeconds << "," << run.solveSeconds << "," << run.decisions << ","
+                << run.propagations << "," << run.peakRssKb << "\n";
+        }
+        return;
+    }
+    out << "[\n";
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const RunResult& run = runs[i];
+        out << "  {\"solver\": " << jsonString(run.solver) << ", \"instance\": " << jsonString(run.instance)
+            << ", \"repetition\": " << run.repetition << ", \"result\": " << jsonString(run.result)
+            << ", \"wall_seconds\": " << run.wallSeconds << ", \"solve_seconds\": " << run.solveSeconds
+            << ", \"decisions\": " << run.decisions << ", \"propagations\": " << run.propagations
+            << ", \"peak_rss_kb\": " << run.peakRssKb << "}" << (i + 1 < runs.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    int repeat = 3;
+    double timeout = 60.0;
+    bool json = false;
+    std::string outputPath;
+    std::string root = ".";
+    std::vector<SolverCommand> solvers;
+    std::vector<std::string> instances;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--repeat" && hasValue) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--timeout" && hasValue) {
+            timeout = std::atof(argv[++i]);
+        } else if (arg == "--format" && hasValue) {
+            json = std::strcmp(argv[++i], "json") == 0;
+        } else if (arg == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else if (arg == "--root" && hasValue) {
+            root = argv[++i];
+        } else if (arg == "--solver" && hasValue) {
+            SolverCommand command;
+            if (!parseSolver(argv[++i], command)) {
+                std::cerr << "Expected NAME=PATH [ARGS...] after --solver" << std::endl;
+                return 1;
+            }
+            solvers.push_back(command);
+        } else if (arg.compare(0, 2, "--") == 0) {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            instances.push_back(arg);
+        }
+    }
+    if (instances.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (solvers.empty()) {
+        for (const char* name : DEFAULT_SOLVERS) solvers.push_back({name, {root + "/" + name + "/solver"}});
+    }
+
+    std::vector<RunResult> runs;
+    for (const std::string& instance : instances) {
+        for (const SolverCommand& solver : solvers) {
+            for (int repetition = 1; repetition <= repeat; ++repetition) {
+                RunResult run = runOnce(solver, instance, timeout);
+                run.repetition = repetition;
+                std::cerr << solver.name << " " << instance << " #" << repetition << ": " << run.result << " "
+                          << run.wallSeconds << "s" << std::endl;
+                runs.push_back(run);
+                // Repeating a timeout would only burn the same budget again
+                if (run.result == "TIMEOUT") break;
+            }
+        }
+    }
+    if (outputPath.empty()) {
+        writeReport(std::cout, runs, json);
+    } else {
+        std::ofstream out(outputPath);
+        writeReport(out, runs, json);
+    }
+    return 0;
+}
@@ -0,0 +1,12 @@
+#include "../Core/frontend.h"
+
+int main(int argc, char* argv[]) {
+    // Conflict-driven clause learning
+    // Options: see parseOptions in Core/options.h
+    SolverOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+    SolverConfig config;
+    if (!applyOptions(options, config)) return 1;
+    config.algorithm = Algorithm::CDCL;
+    return solveAndReport(options, config);
+}
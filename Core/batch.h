@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "clause_arena.h"
+#include "dimacs.h"
+#include "frontend.h"
+#include "json.h"
+#include "options.h"
+#include "solver.h"
+#include "stats.h"
+
+// One formula of a batch. Jobs are recycled: once solved, the arena is cleared and refilled with
+// a later formula, so after the first few rounds it reuses its storage instead of allocating.
+struct BatchJob {
+    size_t index = 0;    // position in the batch, from 0
+    std::string source;  // file the formula came from, "stdin" for standard input
+    ClauseArena formula;
+    bool valid = true;   // false if the formula was malformed
+    double parseSeconds = 0.0;
+};
+
+// Blocking FIFO of jobs; pop returns null once the queue is closed and drained
+class JobQueue {
+public:
+    void push(BatchJob* job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(job);
+        }
+        ready.notify_one();
+    }
+
+    BatchJob* pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this]() { return !jobs.empty() || closed; });
+        if (jobs.empty()) return nullptr;
+        BatchJob* job = jobs.front();
+        jobs.pop_front();
+        return job;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        ready.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<BatchJob*> jobs;
+    bool closed = false;
+};
+
+// Simplifies and solves the formula of job as the options ask and returns its result as one line
+// of JSON: the result, the size of the input, the parsing, preprocessing and solving times, the
+// search statistics and, for satisfiable formulas, the model as a list of literals
+inline std::string solveBatchJob(BatchJob& job, Solver& solver, const SolverOptions& options) {
+    std::ostringstream line;
+    line << "{\"instance\":" << job.index << ",\"source\":" << jsonString(job.source);
+    if (!job.valid) {
+        line << ",\"error\":\"malformed input\"}";
+        return line.str();
+    }
+    int numVars = job.formula.numVars;
+    size_t numClauses = job.formula.numClauses();
+    Frontend frontend(options);
+    double preprocessSeconds = 0.0;
+    {
+        ScopedTimer timer(preprocessSeconds);
+        frontend.simplify(job.formula);
+    }
+    solver.resetStats();
+    auto start = std::chrono::steady_clock::now();
+    SolveResult result = solver.solve(job.formula);
+    std::chrono::duration<double> solveSeconds = std::chrono::steady_clock::now() - start;
+
+    const SolverStats& stats = solver.stats();
+    line << ",\"result\":\"" << resultName(result) << "\",\"variables\":" << numVars
+         << ",\"clauses\":" << numClauses << ",\"parse_seconds\":" << job.parseSeconds;
+    if (options.preprocess || options.eliminate || options.probe || options.symmetry) line << ",\"preprocess_seconds\":" << preprocessSeconds;
+    line << ",\"solve_seconds\":" << solveSeconds.count() << ",\"decisions\":" << stats.decisions
+         << ",\"propagations\":" << stats.propagations << ",\"conflicts\":" << stats.conflicts;
+    if (result == SolveResult::Satisfiable && solver.hasModel()) {
+        Assignment assignment = solver.model();
+        frontend.extendModel(assignment);
+        line << ",\"model\":[";
+        const char* separator = "";
+        for (int var = 1; var <= numVars; ++var) {
+            if (!assignment.assigned(var)) continue;
+            line << separator << (assignment.value(var) ? var : -var);
+            separator = ",";
+        }
+        line << "]";
+    }
+    line << "}";
+    return line.str();
+}
+
+// Batch mode of the single CLI. The input is a stream of formulas (see readDimacs) in a file or on
+// stdin, or a directory whose files are read in name order, each a stream of its own. The reader
+// parses formula after formula into a fixed set of 2 * threads jobs and hands them to a pool of
+// workers, each with one solver for the whole batch; solved jobs go back to the reader for the
+// next formula, so neither side allocates per formula once warmed up, except in the
+// simplifications, which build a new arena each. Every formula gets one JSON line on stdout, in
+// the order they finish, and a summary line goes to stderr at the end.
+inline int runBatch(const SolverOptions& options, const SolverConfig& config) {
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> sources;
+    std::error_code error;
+    if (options.input && std::filesystem::is_directory(options.input, error)) {
+        for (const auto& entry : std::filesystem::directory_iterator(options.input, error)) {
+            if (entry.is_regular_file(error)) sources.push_back(entry.path().string());
+        }
+        std::sort(sources.begin(), sources.end());
+    } else {
+        sources.push_back(options.input ? options.input : "-");
+    }
+
+    std::vector<BatchJob> jobs(2 * threads);
+    JobQueue idle, ready;
+    for (BatchJob& job : jobs) idle.push(&job);
+    std::vector<std::unique_ptr<Solver>> solvers;
+    StatsMonitor monitor(options.progress);
+    for (unsigned i = 0; i < threads; ++i) {
+        solvers.push_back(makeSolver(config));
+        monitor.watch("worker " + std::to_string(i), solvers[i]->stats());
+    }
+    monitor.start();
+    auto begin = std::chrono::steady_clock::now();
+
+    std::mutex outputMutex;
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; ++i) {
+        pool.emplace_back([&, i]() {
+            while (BatchJob* job = ready.pop()) {
+                std::string line = solveBatchJob(*job, *solvers[i], options);
+                {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    std::cout << line << std::endl;
+                }
+                job->formula.clear();
+                idle.push(job);
+            }
+        });
+    }
+
+    size_t count = 0;
+    bool failed = false;
+    for (const std::string& source : sources) {
+        InputBuffer input;
+        if (!input.open(source.c_str())) {
+            std::cerr << "Cannot open " << source << std::endl;
+            failed = true;
+            continue;
+        }
+        while (skipToFormula(input)) {
+            BatchJob* job = idle.pop();
+            job->index = count++;
+            job->source = source == "-" ? "stdin" : source;
+            job->formula.clear();
+            job->parseSeconds = 0.0;
+            {
+                ScopedTimer timer(job->parseSeconds);
+                job->valid = readDimacs(input, job->formula, true);
+            }
+            if (!job->valid) skipToNextFormula(input);
+            ready.push(job);
+        }
+        if (!input.close()) {
+            std::cerr << "Cannot read " << source << std::endl;
+            failed = true;
+        }
+    }
+    ready.close();
+    for (std::thread& thread : pool) thread.join();
+    monitor.stop();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    std::cerr << "Batch: " << count << " formulas in " << elapsed.count() << "s ("
+              << (elapsed.count() > 0.0 ? count / elapsed.count() : 0.0) << " per second) on " << threads
+              << " threads" << std::endl;
+    return failed ? 1 : 0;
+}
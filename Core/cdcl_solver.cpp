@@ -0,0 +1,357 @@
+#include "solver.h"
+#include "variable_order.h"
+#include "learned_clauses.h"
+
+// Implication graph: decision level and reason clause of every assigned variable
+struct ImplicationGraph {
+    std::vector<int> level;
+    std::vector<int> reason;  // -1 for decisions, assumptions and level-0 units
+};
+
+// Conflict-driven clause learning: 1-UIP learning, non-chronological backjumping and VSIDS
+// branching. Learned clauses are appended to the watched clause arena. Between calls the solver
+// sits at decision level 0, where every assignment is a consequence of the clauses alone.
+// Restarts jump back to level 0 whenever the restart policy says so, keeping learned clauses and
+// activities; with restarts on, decisions reuse each variable's last value (phase saving).
+// Learned clauses are scored by LBD and activity and the weaker ones periodically deleted, after
+// which the arena is compacted so it stays within the learned-clause budget. A warm start runs
+// local search on the formula first and takes the best assignment it found as initial phases.
+class CdclSolver : public IncrementalSolver {
+public:
+    explicit CdclSolver(const SolverConfig& config)
+        : policy(config.restarts), phaseSaving(config.restarts != RestartStrategy::None),
+          learnedDb(config.learnedMemory << 20), warmStart(config.warmStart), localSearch(config.localSearch),
+          seed(config.seed) {}
+
+    bool hasModel() const override { return true; }
+
+    SolveResult solve(const ClauseArena& formula) override {
+        // Cleared rather than rebuilt, so a solver reused across formulas keeps its storage
+        assignment.clear();
+        trail.clear();
+        wf.reset(0);
+        graph.level.clear();
+        graph.reason.clear();
+        order.reset(0);
+        phase.clear();
+        policy.reset();
+        learnedDb.reset();
+        inconsistent = false;
+        reserveVars(formula.numVars);
+        wf.clauses.reserve(formula.numClauses(), formula.literals.size());
+        Clause clause;
+        for (ClauseView view : formula) {
+            clause.assign(view.begin(), view.end());
+            addClause(clause);
+        }
+        if (warmStart) counters.flips += warmStartPhases(formula, localSearch, seed, stop, phase);
+        return solve(std::vector<Literal>());
+    }
+
+    // Clauses are simplified against the level-0 assignment: satisfied ones are dropped and false
+    // literals removed, so the first two literals of a stored clause are always open
+    void addClause(const Clause& input) override {
+        backjump(0);
+        if (inconsistent) return;
+        Clause& clause = scratch;
+        clause.clear();
+        for (Literal lit : input) {
+            reserveVars(std::abs(lit));
+            if (isTrue(assignment, lit)) return;
+            if (isFalse(assignment, lit)) continue;
+            if (std::find(clause.begin(), clause.end(), -lit) != clause.end()) return;  // tautology
+            if (std::find(clause.begin(), clause.end(), lit) == clause.end()) clause.push_back(lit);
+        }
+        if (clause.empty()) {
+            inconsistent = true;
+        } else if (clause.size() == 1) {
+            assign(clause[0], -1);
+            counters.propagations++;
+        } else {
+            attachClause(wf, clause);
+            for (Literal lit : clause) order.insert(std::abs(lit));
+        }
+    }
+
+    SolveResult solve(const std::vector<Literal>& assumptions) override {
+        backjump(0);
+        core.clear();
+        if (inconsistent) return SolveResult::Unsatisfiable;
+        for (Literal lit : assumptions) reserveVars(std::abs(lit));
+        SolveResult result = search(assumptions);
+        if (result == SolveResult::Unknown) backjump(0);
+        return result;
+    }
+
+private:
+    void reserveVars(int numVars) {
+        if (numVars <= wf.numVars) return;
+        wf.numVars = numVars;
+        wf.clauses.declareVars(numVars);
+        wf.growLists(numVars);
+        assignment.grow(numVars);
+        graph.level.resize(numVars + 1, 0);
+        graph.reason.resize(numVars + 1, -1);
+        seen.resize(numVars + 1, false);
+        phase.resize(numVars + 1, 1);
+        order.grow(numVars);
+    }
+
+    // Make lit true at the current decision level and record why it was implied
+    void assign(Literal lit, int reason) {
+        assignment.assign(lit);
+        graph.level[std::abs(lit)] = static_cast<int>(trail.levelStart.size());
+        graph.reason[std::abs(lit)] = reason;
+        trail.literals.push_back(lit);
+    }
+
+    // Undo every assignment made above the given decision level and requeue the freed variables
+    void backjump(size_t level) {
+        if (level >= trail.levelStart.size()) return;
+        for (size_t i = trail.levelStart[level]; i < trail.literals.size(); ++i) {
+            Literal lit = trail.literals[i];
+            order.insert(std::abs(lit));
+            if (phaseSaving) phase[std::abs(lit)] = lit > 0;
+        }
+        backtrack(trail, assignment, level);
+    }
+
+    // Literal block distance: the number of distinct decision levels among the clause's literals
+    template <typename Literals>
+    int computeLbd(const Literals& clause) {
+        if (levelStamp.size() <= trail.levelStart.size()) levelStamp.resize(trail.levelStart.size() + 1, 0);
+        stamp++;
+        int lbd = 0;
+        for (Literal lit : clause) {
+            int level = graph.level[std::abs(lit)];
+            if (levelStamp[level] != stamp) {
+                levelStamp[level] = stamp;
+                lbd++;
+            }
+        }
+        return lbd;
+    }
+
+    // Derive the first-UIP clause from a conflict; the asserting literal is placed first and the
+    // literal with the highest remaining level second. Every variable and learned clause met on
+    // the way is bumped. Returns the level to backjump to.
+    int analyzeConflict(int conflict, Clause& learned) {
+        int currentLevel = static_cast<int>(trail.levelStart.size());
+        learned.assign(1, 0);
+        int pending = 0;  // current-level literals still to be resolved away
+        Literal uip = 0;
+        size_t index = trail.literals.size();
+        int reason = conflict;
+        do {
+            if (wf.clauses.headers[reason].flags & CLAUSE_LEARNED) {
+                learnedDb.bump(reason);
+                if (learnedDb.info[reason].tier != ClauseTier::Core) {
+                    learnedDb.updateLbd(reason, computeLbd(wf.clauses[reason]));
+                }
+            }
+            for (Literal lit : wf.clauses[reason]) {
+                int var = std::abs(lit);
+                if (lit == uip || seen[var] || graph.level[var] == 0) continue;
+                seen[var] = true;
+                order.bump(var);
+                if (graph.level[var] == currentLevel) {
+                    pending++;
+                } else {
+                    learned.push_back(lit);
+                }
+            }
+            while (!seen[std::abs(trail.literals[--index])]) {}
+            uip = trail.literals[index];
+            seen[std::abs(uip)] = false;
+            reason = graph.reason[std::abs(uip)];
+            pending--;
+        } while (pending > 0);
+        learned[0] = -uip;
+        // Current-level variables were unmarked as they were resolved; the rest are in the clause
+        for (size_t k = 1; k < learned.size(); ++k) seen[std::abs(learned[k])] = false;
+        order.decayActivities();
+        learnedDb.decayActivities();
+
+        int backjumpLevel = 0;
+        for (size_t k = 1; k < learned.size(); ++k) {
+            int level = graph.level[std::abs(learned[k])];
+            if (level > backjumpLevel) {
+                backjumpLevel = level;
+                std::swap(learned[1], learned[k]);
+            }
+        }
+        return backjumpLevel;
+    }
+
+    // The assumption failed is false under the earlier assumptions. Walks the implication graph
+    // back from it and collects the assumptions it depends on, failed included, into core.
+    void analyzeFinal(Literal failed) {
+        core.assign(1, failed);
+        if (trail.levelStart.empty()) return;
+        seen[std::abs(failed)] = true;
+        for (size_t i = trail.literals.size(); i-- > trail.levelStart[0];) {
+            int var = std::abs(trail.literals[i]);
+            if (!seen[var]) continue;
+            if (graph.reason[var] < 0) {
+                // Only assumptions are decided before the last assumption level
+                core.push_back(trail.literals[i]);
+            } else {
+                for (Literal lit : wf.clauses[graph.reason[var]]) {
+                    if (graph.level[std::abs(lit)] > 0) seen[std::abs(lit)] = true;
+                }
+            }
+            seen[var] = false;  // after its reason, which names var itself
+        }
+        seen[std::abs(failed)] = false;
+    }
+
+    // A reason clause leads with the literal it implied, except binary and ternary clauses, which
+    // are never reordered
+    bool locked(ClauseRef ref) const {
+        ClauseView clause = wf.clauses[ref];
+        size_t candidates = clause.size() <= 3 ? clause.size() : 1;
+        for (size_t k = 0; k < candidates; ++k) {
+            if (graph.reason[std::abs(clause[k])] == ref && isTrue(assignment, clause[k])) return true;
+        }
+        return false;
+    }
+
+    // Deletes the weaker learned clauses, compacts the arena and renumbers the watches, inline
+    // clauses and reasons of the clauses that moved
+    void reduceLearned() {
+        size_t removed = learnedDb.reduce(wf.clauses, counters.conflicts, [&](ClauseRef ref) { return locked(ref); });
+        counters.deleted += static_cast<long long>(removed);
+        if (removed == 0) return;
+        wf.clauses.compact(remap);
+        learnedDb.compact(remap);
+        for (std::vector<int>& watchers : wf.watches) {
+            size_t j = 0;
+            for (int index : watchers) {
+                if (remap[index] >= 0) watchers[j++] = remap[index];
+            }
+            watchers.resize(j);
+        }
+        remapInline(wf.binaries);
+        remapInline(wf.ternaries);
+        for (Literal lit : trail.literals) {
+            int& reason = graph.reason[std::abs(lit)];
+            if (reason >= 0) reason = remap[reason];
+        }
+    }
+
+    template <int N>
+    void remapInline(std::vector<std::vector<InlineClause<N>>>& lists) {
+        for (std::vector<InlineClause<N>>& list : lists) {
+            size_t j = 0;
+            for (InlineClause<N> entry : list) {
+                if (remap[entry.clause] < 0) continue;
+                entry.clause = remap[entry.clause];
+                list[j++] = entry;
+            }
+            list.resize(j);
+        }
+    }
+
+    // Pop variables off the activity heap until an unassigned one turns up
+    Literal getNextVariable() {
+        while (!order.empty()) {
+            int var = order.removeMax();
+            if (!isAssigned(assignment, var)) return var;
+        }
+        return 0;
+    }
+
+    // Assumption i is decided at level i + 1; one already true opens an empty level so the
+    // numbering stays aligned. Conflict analysis may backjump below them, and they are then
+    // re-assumed before the next free decision.
+    SolveResult search(const std::vector<Literal>& assumptions) {
+        Clause learned;
+        while (true) {
+            if (stopRequested()) return SolveResult::Unknown;
+            // Longer clauses keep the literal they imply at position 0, so their reasons lead with it
+            int conflict = propagate(wf, assignment, trail, [&](Literal lit, int reason) {
+                assign(lit, reason);
+                counters.propagations++;
+            });
+            if (conflict >= 0) {
+                counters.conflicts++;
+                counters.visits = wf.visits;
+                if (trail.levelStart.empty()) {
+                    inconsistent = true;
+                    return SolveResult::Unsatisfiable;
+                }
+                int level = analyzeConflict(conflict, learned);
+                int lbd = computeLbd(learned);
+                policy.conflict(lbd);
+                backjump(level);
+                if (learned.size() == 1) {
+                    assign(learned[0], -1);
+                } else {
+                    ClauseRef index = attachClause(wf, learned, CLAUSE_LEARNED);
+                    learnedDb.add(index, learned.size(), lbd);
+                    assign(learned[0], index);
+                }
+                counters.learned++;
+                continue;
+            }
+            if (policy.due()) {
+                backjump(0);
+                policy.restart();
+                counters.restarts++;
+                continue;
+            }
+            if (learnedDb.due(counters.conflicts)) reduceLearned();
+            Literal next = 0;
+            while (trail.levelStart.size() < assumptions.size()) {
+                Literal assumption = assumptions[trail.levelStart.size()];
+                if (isFalse(assignment, assumption)) {
+                    analyzeFinal(assumption);
+                    return SolveResult::Unsatisfiable;
+                }
+                newDecisionLevel(trail);
+                if (!isTrue(assignment, assumption)) {
+                    next = assumption;
+                    break;
+                }
+            }
+            if (next == 0) {
+                next = getNextVariable();
+                if (next == 0) {
+                    return SolveResult::Satisfiable;
+                }
+                if (!phase[next]) next = -next;
+                counters.decisions++;
+                counters.visits = wf.visits;
+                newDecisionLevel(trail);
+                counters.maxDepth.raise(static_cast<long long>(trail.levelStart.size()));
+            }
+            assign(next, -1);
+        }
+    }
+
+    WatchedFormula wf;
+    Trail trail;
+    ImplicationGraph graph;
+    VariableOrder order;
+    Clause scratch;
+    RestartPolicy policy;
+    bool phaseSaving;
+    LearnedClauses learnedDb;
+    std::vector<ClauseRef> remap;  // scratch of reduceLearned
+    bool warmStart;
+    LocalSearchConfig localSearch;
+    unsigned seed;
+    std::vector<signed char> phase;  // value each variable is decided with, 1 for true
+    std::vector<bool> seen;  // scratch of analyzeConflict and analyzeFinal, all false between calls
+    std::vector<unsigned> levelStamp;  // scratch of computeLbd, indexed by decision level
+    unsigned stamp = 0;
+    bool inconsistent = false;  // the clauses alone are unsatisfiable
+};
+
+std::unique_ptr<Solver> makeCdclSolver(const SolverConfig& config) {
+    return std::make_unique<CdclSolver>(config);
+}
+
+std::unique_ptr<IncrementalSolver> makeIncrementalSolver(const SolverConfig& config) {
+    return std::make_unique<CdclSolver>(config);
+}
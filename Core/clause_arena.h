@@ -0,0 +1,219 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+
+using Literal = int;
+using ClauseRef = int;  // index of a clause header in the arena
+
+enum ClauseFlags : uint32_t {
+    CLAUSE_DELETED = 1,
+    CLAUSE_LEARNED = 2
+};
+
+struct ClauseHeader {
+    uint32_t offset;  // position of the first literal in the literal buffer
+    uint32_t size;
+    uint32_t flags;
+};
+
+// Contiguous range of literals belonging to one clause
+struct ClauseView {
+    Literal* first;
+    Literal* last;
+
+    Literal* begin() const { return first; }
+    Literal* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+    Literal& operator[](size_t i) const { return first[i]; }
+};
+
+struct ClauseArena;
+
+// Walks the clauses of an arena in reference order
+struct ClauseIterator {
+    const ClauseArena* arena;
+    ClauseRef ref;
+
+    ClauseView operator*() const;
+    ClauseIterator& operator++() { ++ref; return *this; }
+    bool operator!=(const ClauseIterator& other) const { return ref != other.ref; }
+};
+
+// All clauses of a formula in one literal buffer, addressed through small fixed-size headers.
+// Views and pointers into the buffer are invalidated by add(), references are not.
+struct ClauseArena {
+    std::vector<Literal> literals;
+    std::vector<ClauseHeader> headers;
+    int numVars = 0;
+
+    void reserve(size_t numClauses, size_t numLiterals) {
+        headers.reserve(numClauses);
+        literals.reserve(numLiterals);
+    }
+
+    // Variables named in a DIMACS header count even if no clause mentions them
+    void declareVars(int count) { numVars = std::max(numVars, count); }
+
+    ClauseRef add(const Literal* lits, size_t size, uint32_t flags = 0) {
+        ClauseRef ref = static_cast<ClauseRef>(headers.size());
+        headers.push_back({static_cast<uint32_t>(literals.size()), static_cast<uint32_t>(size), flags});
+        for (size_t i = 0; i < size; ++i) {
+            literals.push_back(lits[i]);
+            numVars = std::max(numVars, std::abs(lits[i]));
+        }
+        return ref;
+    }
+
+    ClauseRef add(const std::vector<Literal>& clause, uint32_t flags = 0) {
+        return add(clause.data(), clause.size(), flags);
+    }
+
+    ClauseView operator[](ClauseRef ref) {
+        Literal* first = literals.data() + headers[ref].offset;
+        return {first, first + headers[ref].size};
+    }
+
+    ClauseView operator[](ClauseRef ref) const {
+        Literal* first = const_cast<Literal*>(literals.data()) + headers[ref].offset;
+        return {first, first + headers[ref].size};
+    }
+
+    ClauseIterator begin() const { return {this, 0}; }
+    ClauseIterator end() const { return {this, static_cast<ClauseRef>(headers.size())}; }
+
+    size_t size(ClauseRef ref) const { return headers[ref].size; }
+    size_t numClauses() const { return headers.size(); }
+    bool empty() const { return headers.empty(); }
+
+    bool deleted(ClauseRef ref) const { return headers[ref].flags & CLAUSE_DELETED; }
+    void markDeleted(ClauseRef ref) { headers[ref].flags |= CLAUSE_DELETED; }
+
+    // Drops lit from the clause in place, keeping the order of the remaining literals
+    void removeLiteral(ClauseRef ref, Literal lit) {
+        ClauseView clause = (*this)[ref];
+        Literal* last = std::remove(clause.begin(), clause.end(), lit);
+        headers[ref].size = static_cast<uint32_t>(last - clause.begin());
+    }
+
+    // Drops deleted clauses and closes the gaps they and removed literals leave in the buffer.
+    // remap[old] is the new reference of each clause, -1 for deleted ones.
+    void compact(std::vector<ClauseRef>& remap) {
+        remap.assign(headers.size(), -1);
+        size_t kept = 0;
+        size_t used = 0;
+        for (size_t ref = 0; ref < headers.size(); ++ref) {
+            if (headers[ref].flags & CLAUSE_DELETED) continue;
+            ClauseHeader header = headers[ref];
+            std::copy(literals.begin() + header.offset, literals.begin() + header.offset + header.size,
+                      literals.begin() + used);
+            header.offset = static_cast<uint32_t>(used);
+            used += header.size;
+            headers[kept] = header;
+            remap[ref] = static_cast<ClauseRef>(kept++);
+        }
+        headers.resize(kept);
+        literals.resize(used);
+    }
+
+    void clear() {
+        literals.clear();
+        headers.clear();
+        numVars = 0;
+    }
+};
+
+inline ClauseView ClauseIterator::operator*() const {
+    return (*arena)[ref];
+}
+
+// FNV-1a hash of a clause; clauses compared through it must be sorted
+inline uint64_t hashClause(const Literal* lits, size_t size) {
+    uint64_t h = 1469598103934665603ULL ^ size;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= static_cast<uint32_t>(lits[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Duplicate-free clause set on top of an arena. Clauses are stored with sorted, unique literals
+// and looked up through an open-addressing table of clause references.
+struct ClauseSet {
+    ClauseArena arena;
+    std::vector<ClauseRef> table;  // -1 marks an empty slot
+    bool hasEmptyClause = false;
+
+    // Returns true if the clause was not present yet
+    bool insert(std::vector<Literal>& clause) {
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        if (find(clause) >= 0) return false;
+        if (2 * (arena.numClauses() + 1) > table.size()) grow();
+        ClauseRef ref = arena.add(clause);
+        place(ref);
+        if (clause.empty()) hasEmptyClause = true;
+        return true;
+    }
+
+    // Looks up a sorted, duplicate-free clause; returns -1 if absent
+    ClauseRef find(const std::vector<Literal>& clause) const {
+        if (table.empty()) return -1;
+        size_t mask = table.size() - 1;
+        for (size_t slot = hashClause(clause.data(), clause.size()) & mask; table[slot] >= 0; slot = (slot + 1) & mask) {
+            ClauseView stored = arena[table[slot]];
+            if (arena.deleted(table[slot])) continue;
+            if (stored.size() == clause.size() && std::equal(stored.begin(), stored.end(), clause.begin())) {
+                return table[slot];
+            }
+        }
+        return -1;
+    }
+
+    void reserve(size_t numClauses, size_t numLiterals) {
+        arena.reserve(numClauses, numLiterals);
+        size_t slots = 16;
+        while (slots < 2 * numClauses) slots *= 2;
+        if (slots > table.size()) {
+            table.assign(slots, -1);
+            for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(arena.numClauses()); ++ref) place(ref);
+        }
+    }
+
+    void declareVars(int count) { arena.declareVars(count); }
+
+    void insertAll(const ClauseArena& formula) {
+        reserve(formula.numClauses(), formula.literals.size());
+        declareVars(formula.numVars);
+        std::vector<Literal> clause;
+        for (ClauseView view : formula) {
+            clause.assign(view.begin(), view.end());
+            insert(clause);
+        }
+    }
+
+    // Erased clauses stay in the table as tombstones until the set is rebuilt
+    void erase(ClauseRef ref) { arena.markDeleted(ref); }
+    bool deleted(ClauseRef ref) const { return arena.deleted(ref); }
+
+    size_t size() const { return arena.numClauses(); }
+    bool empty() const { return arena.empty(); }
+    ClauseView operator[](ClauseRef ref) const { return arena[ref]; }
+
+private:
+    void place(ClauseRef ref) {
+        ClauseView clause = arena[ref];
+        size_t mask = table.size() - 1;
+        size_t slot = hashClause(clause.begin(), clause.size()) & mask;
+        while (table[slot] >= 0) slot = (slot + 1) & mask;
+        table[slot] = ref;
+    }
+
+    void grow() {
+        table.assign(table.empty() ? 16 : 2 * table.size(), -1);
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(arena.numClauses()); ++ref) place(ref);
+    }
+};
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include "clause_arena.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Byte source for the parser: a memory-mapped file, or a refillable buffer over a stream
+// (stdin, a plain file where mapping is unavailable, or the output of gzip -dc)
+class InputBuffer {
+public:
+    InputBuffer() = default;
+    InputBuffer(const InputBuffer&) = delete;
+    InputBuffer& operator=(const InputBuffer&) = delete;
+
+    ~InputBuffer() { close(); }
+
+    // Opens path, or stdin when path is null or "-"; returns false if the input cannot be read
+    bool open(const char* path) {
+        if (!path || std::strcmp(path, "-") == 0) return stream(stdin);
+#ifndef _WIN32
+        size_t length = std::strlen(path);
+        if (length > 3 && std::strcmp(path + length - 3, ".gz") == 0) {
+            std::string command = "gzip -dc -- '";
+            for (const char* c = path; *c; ++c) {
+                if (*c == '\'') command += "'\\''";
+                else command += *c;
+            }
+            command += "'";
+            if (!stream(popen(command.c_str(), "r"))) return false;
+            pipe = true;
+            return true;
+        }
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                madvise(data, info.st_size, MADV_SEQUENTIAL);
+                mapping = data;
+                mappedSize = info.st_size;
+                pos = static_cast<const char*>(data);
+                end = pos + mappedSize;
+                ::close(fd);
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+        return stream(std::fopen(path, "rb"));
+    }
+
+    // Releases the input; false if it came through gzip and gzip failed, for a missing or corrupt
+    // file reads as an empty one
+    bool close() {
+        bool ok = true;
+#ifndef _WIN32
+        if (mapping) munmap(mapping, mappedSize);
+        mapping = nullptr;
+        if (pipe) {
+            int status = pclose(file);
+            ok = status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            file = nullptr;
+            pipe = false;
+        }
+#endif
+        if (file && file != stdin) fclose(file);
+        file = nullptr;
+        pos = end = nullptr;
+        return ok;
+    }
+
+    // Size of the input in bytes if it is known up front, otherwise 0
+    size_t knownSize() const { return mappedSize; }
+
+    int peek() {
+        if (pos == end && !refill()) return EOF;
+        return static_cast<unsigned char>(*pos);
+    }
+
+    void advance() { ++pos; }
+
+    int lineNumber = 1;  // kept by the parser, for error messages
+
+private:
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    FILE* file = nullptr;
+    bool pipe = false;
+    std::vector<char> buffer;
+    void* mapping = nullptr;
+    size_t mappedSize = 0;
+
+    bool stream(FILE* input) {
+        file = input;
+        buffer.resize(1 << 16);
+        return file != nullptr;
+    }
+
+    bool refill() {
+        if (!file) return false;
+        size_t count = std::fread(buffer.data(), 1, buffer.size(), file);
+        if (count == 0) return false;
+        pos = buffer.data();
+        end = pos + count;
+        return true;
+    }
+};
+
+// Largest variable the parser accepts; solvers index per-literal tables by 2 * var + 1
+constexpr int MAX_VARIABLE = INT_MAX / 2 - 1;
+
+// Clauses reserved up front when the input size is unknown; the arena grows past it as needed
+constexpr size_t STREAM_RESERVE = 1 << 16;
+
+inline void reserveFormula(ClauseArena& formula, size_t numClauses, size_t numLiterals) {
+    formula.reserve(numClauses, numLiterals);
+}
+
+inline void addClause(ClauseArena& formula, std::vector<Literal>& clause) {
+    formula.add(clause);
+}
+
+// Consumes the rest of the current line and the lines after it, up to the next header or empty
+// line, where the next formula of a stream can start
+inline void skipToNextFormula(InputBuffer& input) {
+    bool lineStart = false;
+    for (int c = input.peek(); c != EOF; c = input.peek()) {
+        if (lineStart && (c == 'p' || c == '\n')) return;
+        lineStart = c == '\n';
+        if (lineStart) input.lineNumber++;
+        input.advance();
+    }
+}
+
+// Skips the empty and comment lines in front of the next formula of a stream; false once nothing
+// is left
+inline bool skipToFormula(InputBuffer& input) {
+    for (int c = input.peek(); c != EOF; c = input.peek()) {
+        if (c == 'c') {
+            for (; c != EOF && c != '\n'; c = input.peek()) input.advance();
+        } else if (c == '\n') {
+            input.lineNumber++;
+            input.advance();
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            input.advance();
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Reads a CNF formula. With a "p cnf <vars> <clauses>" header the input is standard DIMACS:
+// "c" comment lines, clauses terminated by 0 and free to span lines, and "%" ending the input.
+// Without a header every non-empty line is one clause and the first empty line ends the formula.
+// With stream set the input may hold more formulas after this one: a formula also ends where the
+// next header starts, and "%" skips ahead to the next header or empty line. Returns false and
+// reports on stderr if the input is malformed.
+template <typename Formula>
+bool readDimacs(InputBuffer& input, Formula& formula, bool stream = false) {
+    bool header = false;
+    bool blankLine = true;
+    bool sawClause = false;
+    std::vector<Literal> clause;
+    while (true) {
+        int c = input.peek();
+        if (c == EOF) break;
+        if (c == '%') {
+            if (stream) skipToNextFormula(input);
+            break;
+        }
+        if (c == '\n') {
+            input.advance();
+            input.lineNumber++;
+            if (!header) {
+                if (!clause.empty()) {
+                    addClause(formula, clause);
+                    clause.clear();
+                    sawClause = true;
+                } else if (blankLine && sawClause) {
+                    break;
+                }
+            }
+            blankLine = true;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            input.advance();
+        } else if (c == 'p' && stream && (header || sawClause || !clause.empty())) {
+            break;
+        } else if (c == 'c' || c == 'p') {
+            blankLine = false;
+            std::string line;
+            for (; c != EOF && c != '\n'; c = input.peek()) {
+                line += static_cast<char>(c);
+                input.advance();
+            }
+            if (line[0] == 'p') {
+                int numVars = 0;
+                long long numClauses = 0;
+                if (std::sscanf(line.c_str(), "p cnf %d %lld", &numVars, &numClauses) != 2 || numVars < 0 || numClauses < 0
+                    || numVars > MAX_VARIABLE) {
+                    std::cerr << "Malformed header on line " << input.lineNumber << ": " << line << std::endl;
+                    return false;
+                }
+                header = true;
+                // Random k-SAT style inputs average about three literals per clause; the size of a
+                // stream says nothing about a single formula. Every clause and literal takes at least
+                // two bytes, so a header claiming more than the input can hold is not trusted.
+                size_t limit = stream || input.knownSize() == 0 ? STREAM_RESERVE : input.knownSize() / 2;
+                size_t clauses = std::min<size_t>(numClauses, limit);
+                size_t fromSize = stream ? 0 : input.knownSize() / 4;
+                try {
+                    reserveFormula(formula, clauses, std::min(std::max(3 * clauses, fromSize), limit));
+                    formula.declareVars(numVars);
+                } catch (const std::exception&) {  // bad_alloc or length_error
+                    std::cerr << "Header too large on line " << input.lineNumber << ": " << line << std::endl;
+                    return false;
+                }
+            }
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+            bool negative = c == '-';
+            if (negative) {
+                input.advance();
+                c = input.peek();
+                if (c < '0' || c > '9') {
+                    std::cerr << "Expected a literal on line " << input.lineNumber << std::endl;
+                    return false;
+                }
+            }
+            int value = 0;
+            for (; c >= '0' && c <= '9'; c = input.peek()) {
+                if (value > (MAX_VARIABLE - (c - '0')) / 10) {
+                    std::cerr << "Literal out of range on line " << input.lineNumber << std::endl;
+                    return false;
+                }
+                value = value * 10 + (c - '0');
+                input.advance();
+            }
+            blankLine = false;
+            if (value == 0) {
+                addClause(formula, clause);
+                clause.clear();
+                sawClause = true;
+            } else {
+                clause.push_back(negative ? -value : value);
+            }
+        } else {
+            std::cerr << "Unexpected character '" << static_cast<char>(c) << "' on line " << input.lineNumber << std::endl;
+            return false;
+        }
+    }
+    // The last clause may be missing its terminator or the trailing newline
+    if (!clause.empty()) addClause(formula, clause);
+    return true;
+}
+
+// Reads the formula in path, or stdin when path is null or "-"
+template <typename Formula>
+bool readDimacs(const char* path, Formula& formula) {
+    InputBuffer input;
+    if (!input.open(path)) {
+        std::cerr << "Cannot open " << (path ? path : "stdin") << std::endl;
+        return false;
+    }
+    bool ok = readDimacs(input, formula);
+    if (!input.close()) {
+        std::cerr << "Cannot read " << (path ? path : "stdin") << std::endl;
+        return false;
+    }
+    return ok;
+}
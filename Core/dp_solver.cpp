@@ -0,0 +1,140 @@
+#include "solver.h"
+#include "elimination.h"
+#include "packed_clause.h"
+
+// Eliminator's unbounded run over packed clauses, for formulas with at most PACKED_MAX_VARS
+// variables. Variables are picked in the same order, so the counts match.
+struct PackedEliminator {
+    PackedClauses formula;
+    std::vector<std::vector<ClauseRef>> occurs;
+    std::vector<int> count;
+    std::vector<bool> eliminated;
+    std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>,
+                        std::greater<std::pair<long long, int>>> queue;
+    std::vector<uint64_t> generated;  // resolvents of the current variable, stride() words each
+    std::vector<ClauseRef> remap;
+    size_t liveClauses = 0;
+    size_t eliminatedVars = 0;
+    size_t resolvents = 0;
+    bool unsat = false;
+
+    explicit PackedEliminator(const ClauseArena& input)
+        : formula(input.numVars), occurs(2 * input.numVars + 2), count(2 * input.numVars + 2, 0),
+          eliminated(input.numVars + 1, false) {
+        std::vector<uint64_t> clause(formula.stride());
+        for (ClauseView view : input) {
+            formula.pack(view.begin(), view.size(), clause.data());
+            if (!formula.tautology(clause.data())) addClause(clause.data());
+        }
+    }
+
+    long long cost(int var) const {
+        return static_cast<long long>(count[Eliminator::occurrenceIndex(var)]) * count[Eliminator::occurrenceIndex(-var)];
+    }
+
+    void touch(int var) {
+        if (!eliminated[var]) queue.push({cost(var), var});
+    }
+
+    void addClause(const uint64_t* clause) {
+        ClauseRef ref = formula.insert(clause);
+        if (ref < 0) return;
+        if (formula.size(ref) == 0) unsat = true;
+        liveClauses++;
+        formula.forEachLiteral(formula[ref], [&](Literal lit) {
+            occurs[Eliminator::occurrenceIndex(lit)].push_back(ref);
+            count[Eliminator::occurrenceIndex(lit)]++;
+            touch(std::abs(lit));
+        });
+    }
+
+    void removeClause(ClauseRef ref, Literal pivot) {
+        formula.erase(ref);
+        liveClauses--;
+        formula.forEachLiteral(formula[ref], [&](Literal lit) {
+            count[Eliminator::occurrenceIndex(lit)]--;
+            if (lit != pivot) touch(std::abs(lit));
+        });
+    }
+
+    std::vector<ClauseRef>& occurrences(Literal lit) {
+        std::vector<ClauseRef>& list = occurs[Eliminator::occurrenceIndex(lit)];
+        list.erase(std::remove_if(list.begin(), list.end(), [&](ClauseRef ref) { return formula.deleted(ref); }), list.end());
+        return list;
+    }
+
+    void eliminate(int var) {
+        std::vector<ClauseRef> pos = occurrences(var);
+        std::vector<ClauseRef> neg = occurrences(-var);
+        size_t stride = formula.stride();
+        generated.clear();
+        for (ClauseRef p : pos) {
+            for (ClauseRef n : neg) {
+                generated.resize(generated.size() + stride);
+                uint64_t* resolvent = generated.data() + generated.size() - stride;
+                if (!formula.resolve(formula[p], formula[n], var, resolvent)) generated.resize(generated.size() - stride);
+            }
+        }
+        eliminated[var] = true;
+        eliminatedVars++;
+        for (ClauseRef p : pos) removeClause(p, var);
+        for (ClauseRef n : neg) removeClause(n, -var);
+        for (size_t offset = 0; offset < generated.size(); offset += stride) {
+            addClause(generated.data() + offset);
+            resolvents++;
+        }
+        if (formula.numClauses() > 2 * liveClauses + 1024) compact();
+    }
+
+    void run() {
+        for (int var = 1; var < static_cast<int>(eliminated.size()); ++var) touch(var);
+        while (!queue.empty() && !unsat) {
+            std::pair<long long, int> top = queue.top();
+            queue.pop();
+            int var = top.second;
+            if (eliminated[var] || top.first != cost(var)) continue;
+            if (count[Eliminator::occurrenceIndex(var)] == 0 && count[Eliminator::occurrenceIndex(-var)] == 0) continue;
+            eliminate(var);
+        }
+    }
+
+    void compact() {
+        formula.compact(remap);
+        for (std::vector<ClauseRef>& list : occurs) {
+            size_t j = 0;
+            for (ClauseRef ref : list) {
+                if (remap[ref] >= 0) list[j++] = remap[ref];
+            }
+            list.resize(j);
+        }
+    }
+};
+
+// Davis-Putnam: eliminate variables by resolution, always taking the one with the fewest
+// pos x neg resolvents, until the empty clause is derived (unsatisfiable) or no variable is left
+// (satisfiable). No model is built. Formulas with few variables are handled on packed clauses.
+class DpSolver : public Solver {
+public:
+    SolveResult solve(const ClauseArena& formula) override {
+        if (formula.numVars <= PACKED_MAX_VARS) {
+            PackedEliminator eliminator(formula);
+            eliminator.run();
+            return report(eliminator);
+        }
+        Eliminator eliminator(formula);
+        eliminator.run(false);
+        return report(eliminator);
+    }
+
+private:
+    template <typename Engine>
+    SolveResult report(const Engine& eliminator) {
+        counters.eliminated += static_cast<long long>(eliminator.eliminatedVars);
+        counters.resolvents += static_cast<long long>(eliminator.resolvents);
+        return eliminator.unsat ? SolveResult::Unsatisfiable : SolveResult::Satisfiable;
+    }
+};
+
+std::unique_ptr<Solver> makeDpSolver() {
+    return std::make_unique<DpSolver>();
+}
@@ -0,0 +1,220 @@
+#include <random>
+#include "solver.h"
+#include "variable_order.h"
+#include "static_order.h"
+
+// Recursive DPLL over two watched literals. The heuristics differ only in how the next branch
+// literal is picked:
+// - First: first unassigned literal of the first clause that is not yet satisfied
+// - Static, JeroslowWang, MOMS: first unassigned variable of an order sorted once by occurrence
+//   count, Jeroslow-Wang score or MOMS score in the input formula; the last two also pick the
+//   polarity their score prefers
+// - Dynamic: most frequent unassigned variable in the clauses that are not yet satisfied
+// - VSIDS: highest activity in an indexed heap, bumped for the variables of every conflict
+// - Random: fixed random variable order with a random polarity at each decision
+// A variable with a saved phase (below) is decided with that value instead of the polarity
+// picked here.
+// With restarts on, a due restart unwinds the recursion back to the root and the search starts
+// over, and the random heuristic draws a fresh order. Restarts also turn on phase saving: a
+// variable that was assigned and then unwound, by backtracking or by a restart, is next decided
+// with the value it last had, while one never assigned keeps the polarity its heuristic picks.
+// DPLL learns no clauses to score, so LBD restarts fall back to Luby, whose growing budgets keep
+// the search complete. A warm start runs local search first and decides every variable with the
+// value it had in the best assignment found.
+class DpllSolver : public Solver {
+public:
+    explicit DpllSolver(const SolverConfig& config)
+        : heuristic(config.heuristic), rng(config.seed),
+          policy(config.restarts == RestartStrategy::LBD ? RestartStrategy::Luby : config.restarts),
+          phaseSaving(config.restarts != RestartStrategy::None), warmStart(config.warmStart),
+          localSearch(config.localSearch), seed(config.seed) {
+        // Without learned clauses every restart repeats work, so the budgets start larger
+        policy.unit = 1000;
+    }
+
+    bool hasModel() const override { return true; }
+
+    SolveResult solve(const ClauseArena& formula) override {
+        assignment.reset(formula.numVars);
+        trail.clear();
+        cancelled = false;
+        restarting = false;
+        policy.reset();
+        buildWatches(formula, wf);
+        phase.assign(formula.numVars + 1, -1);
+        if (wf.hasEmptyClause) return SolveResult::Unsatisfiable;
+        if (warmStart) counters.flips += warmStartPhases(formula, localSearch, seed, stop, phase);
+        initOrder(formula);
+        for (Literal unit : wf.units) {
+            if (isTrue(assignment, unit)) continue;
+            if (!enqueue(assignment, trail, unit)) return SolveResult::Unsatisfiable;
+            counters.propagations++;
+        }
+        while (true) {
+            bool satisfiable = dpll();
+            if (cancelled) return SolveResult::Unknown;
+            if (!restarting) return satisfiable ? SolveResult::Satisfiable : SolveResult::Unsatisfiable;
+            restarting = false;
+            policy.restart();
+            counters.restarts++;
+            if (heuristic == Heuristic::Random) {
+                std::shuffle(order.order.begin(), order.order.end(), rng);
+                order.reset();
+            }
+        }
+    }
+
+private:
+    void initOrder(const ClauseArena& formula) {
+        order = StaticOrder();
+        if (heuristic == Heuristic::Static) {
+            order.build(formula, StaticScore::Frequency);
+        } else if (heuristic == Heuristic::JeroslowWang) {
+            order.build(formula, StaticScore::JeroslowWang);
+        } else if (heuristic == Heuristic::MOMS) {
+            order.build(formula, StaticScore::MOMS);
+        } else if (heuristic == Heuristic::Random) {
+            for (int var = 1; var <= formula.numVars; ++var) order.order.push_back(var);
+            std::shuffle(order.order.begin(), order.order.end(), rng);
+        } else if (heuristic == Heuristic::VSIDS) {
+            activity.reset(formula.numVars);
+            for (Literal lit : formula.literals) activity.insert(std::abs(lit));
+        } else if (heuristic == Heuristic::Dynamic) {
+            frequency.assign(formula.numVars + 1, 0);
+        }
+    }
+
+    bool unsatisfied(ClauseView clause) const {
+        for (Literal lit : clause) {
+            if (isTrue(assignment, lit)) return false;
+        }
+        return true;
+    }
+
+    // Returns the literal to branch on first, or 0 once the formula is satisfied
+    Literal nextLiteral() {
+        switch (heuristic) {
+            case Heuristic::First:
+                for (ClauseView clause : wf.clauses) {
+                    if (!unsatisfied(clause)) continue;
+                    for (Literal lit : clause) {
+                        if (!isFalse(assignment, lit)) return std::abs(lit);
+                    }
+                }
+                return 0;
+            case Heuristic::Static:
+            case Heuristic::JeroslowWang:
+            case Heuristic::MOMS:
+                return order.nextLiteral(assignment);
+            case Heuristic::Dynamic: {
+                Literal best = 0;
+                int bestCount = 0;
+                for (ClauseView clause : wf.clauses) {
+                    if (!unsatisfied(clause)) continue;
+                    for (Literal lit : clause) {
+                        int var = std::abs(lit);
+                        if (isAssigned(assignment, var)) continue;
+                        if (++frequency[var] > bestCount) {
+                            best = var;
+                            bestCount = frequency[var];
+                        }
+                    }
+                }
+                std::fill(frequency.begin(), frequency.end(), 0);
+                return best;
+            }
+            case Heuristic::VSIDS:
+                // Pop variables off the activity heap until an unassigned one turns up
+                while (!activity.empty()) {
+                    int var = activity.removeMax();
+                    if (!isAssigned(assignment, var)) return var;
+                }
+                return 0;
+            case Heuristic::Random: {
+                int var = order.next(assignment);
+                if (var == 0) return 0;
+                return (rng() & 1) ? -var : var;
+            }
+        }
+        return 0;
+    }
+
+    // Undo the given decision level and above; VSIDS requeues the freed variables, phase saving
+    // remembers their values and the fixed orders move their cursor back
+    void undo(size_t level) {
+        if (heuristic == Heuristic::VSIDS || phaseSaving) {
+            for (size_t i = trail.levelStart[level]; i < trail.literals.size(); ++i) {
+                Literal lit = trail.literals[i];
+                if (heuristic == Heuristic::VSIDS) activity.insert(std::abs(lit));
+                if (phaseSaving) phase[std::abs(lit)] = lit > 0;
+            }
+        }
+        backtrack(trail, assignment, level);
+        order.restore(level);
+    }
+
+    bool branch(Literal lit, size_t level) {
+        order.save(level);
+        counters.decisions++;
+        counters.maxDepth.raise(static_cast<long long>(level) + 1);
+        counters.visits = wf.visits;
+        newDecisionLevel(trail);
+        enqueue(assignment, trail, lit);
+        if (dpll()) return true;
+        undo(level);
+        return false;
+    }
+
+    bool dpll() {
+        if (stopRequested()) {
+            cancelled = true;
+            return false;
+        }
+        int conflict = propagate(wf, assignment, trail, [&](Literal lit, int) {
+            enqueue(assignment, trail, lit);
+            counters.propagations++;
+        });
+        if (conflict >= 0) {
+            counters.conflicts++;
+            counters.visits = wf.visits;
+            if (heuristic == Heuristic::VSIDS) {
+                // Variables of the falsified clause caused the conflict
+                for (Literal lit : wf.clauses[conflict]) activity.bump(std::abs(lit));
+                activity.decayActivities();
+            }
+            policy.conflict(0);
+            if (policy.due() && !trail.levelStart.empty()) restarting = true;
+            return false;
+        }
+        Literal lit = nextLiteral();
+        if (lit == 0) {
+            return true;
+        }
+        int var = std::abs(lit);
+        if (phase[var] >= 0) lit = phase[var] ? var : -var;
+        size_t level = trail.levelStart.size();
+        if (branch(lit, level)) return true;
+        if (cancelled || restarting) return false;
+        return branch(-lit, level);
+    }
+
+    Heuristic heuristic;
+    std::mt19937 rng;
+    WatchedFormula wf;
+    Trail trail;
+    StaticOrder order;           // fixed variable order of the static and random heuristics
+    std::vector<int> frequency;  // scratch counts of the dynamic heuristic
+    VariableOrder activity;
+    RestartPolicy policy;
+    bool phaseSaving;
+    bool warmStart;
+    LocalSearchConfig localSearch;
+    unsigned seed;
+    std::vector<signed char> phase;  // saved value of each variable, 1 for true, -1 if there is none
+    bool cancelled = false;
+    bool restarting = false;
+};
+
+std::unique_ptr<Solver> makeDpllSolver(const SolverConfig& config) {
+    return std::make_unique<DpllSolver>(config);
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include "clause_arena.h"
+#include "preprocess.h"
+
+// Clauses removed by variable elimination, each with the literal of the variable it was removed for.
+// Replaying it backwards turns a model of the remaining formula into a model of the original one.
+struct EliminationStack {
+    ClauseArena clauses;
+    std::vector<Literal> pivots;
+
+    void record(ClauseView clause, Literal pivot) {
+        clauses.add(clause.begin(), clause.size());
+        pivots.push_back(pivot);
+    }
+
+    template <typename Assignment>
+    void extendModel(Assignment& assignment) const {
+        // Eliminated variables and those the solver left open start out false, so every clause below
+        // is decided; an eliminated variable only changes if one of its own clauses needs it
+        for (Literal lit : clauses.literals) {
+            if (!assignment.assigned(std::abs(lit))) assignment.assign(-std::abs(lit));
+        }
+        for (ClauseRef ref = static_cast<ClauseRef>(clauses.numClauses()) - 1; ref >= 0; --ref) {
+            bool satisfied = false;
+            for (Literal lit : clauses[ref]) {
+                if (assignment.value(std::abs(lit)) == (lit > 0)) {
+                    satisfied = true;
+                    break;
+                }
+            }
+            if (!satisfied) assignment.assign(pivots[ref]);
+        }
+    }
+};
+
+// Davis-Putnam variable elimination over occurrence lists. Variables are scheduled through a lazy
+// min-queue keyed by the product of their positive and negative occurrence counts; an entry whose
+// key no longer matches the counts is stale, since every count change pushes a fresh one.
+struct Eliminator {
+    ClauseSet formula;
+    std::vector<std::vector<ClauseRef>> occurs;  // indexed by occurrenceIndex(lit), pruned lazily
+    std::vector<int> count;                      // live occurrences of each literal
+    std::vector<bool> eliminated;
+    std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>,
+                        std::greater<std::pair<long long, int>>> queue;
+    EliminationStack* stack;  // receives removed clauses when the model is needed afterwards
+    ClauseArena generated;
+    std::vector<Literal> resolvent;
+    size_t liveClauses = 0;
+    size_t eliminatedVars = 0;
+    size_t resolvents = 0;
+    bool unsat = false;
+
+    explicit Eliminator(const ClauseArena& input, EliminationStack* stack = nullptr)
+        : occurs(2 * input.numVars + 2), count(2 * input.numVars + 2, 0), eliminated(input.numVars + 1, false), stack(stack) {
+        formula.reserve(input.numClauses(), input.literals.size());
+        formula.declareVars(input.numVars);
+        std::vector<Literal> clause;
+        for (ClauseView view : input) {
+            clause.assign(view.begin(), view.end());
+            if (!tautology(clause)) addClause(clause);
+        }
+    }
+
+    static int occurrenceIndex(Literal lit) {
+        return lit > 0 ? 2 * lit : 2 * (-lit) + 1;
+    }
+
+    static bool tautology(std::vector<Literal>& clause) {
+        std::sort(clause.begin(), clause.end());
+        for (Literal lit : clause) {
+            if (lit > 0 && std::binary_search(clause.begin(), clause.end(), -lit)) return true;
+        }
+        return false;
+    }
+
+    long long cost(int var) const {
+        return static_cast<long long>(count[occurrenceIndex(var)]) * count[occurrenceIndex(-var)];
+    }
+
+    void touch(int var) {
+        if (!eliminated[var]) queue.push({cost(var), var});
+    }
+
+    void addClause(std::vector<Literal>& clause) {
+        if (!formula.insert(clause)) return;
+        if (clause.empty()) unsat = true;
+        ClauseRef ref = static_cast<ClauseRef>(formula.size()) - 1;
+        liveClauses++;
+        for (Literal lit : clause) {
+            occurs[occurrenceIndex(lit)].push_back(ref);
+            count[occurrenceIndex(lit)]++;
+            touch(std::abs(lit));
+        }
+    }
+
+    void removeClause(ClauseRef ref, Literal pivot) {
+        if (stack) stack->record(formula[ref], pivot);
+        formula.erase(ref);
+        liveClauses--;
+        for (Literal lit : formula[ref]) {
+            count[occurrenceIndex(lit)]--;
+            if (lit != pivot) touch(std::abs(lit));
+        }
+    }
+
+    // Live clauses containing lit; deleted references are dropped from the list on the way
+    std::vector<ClauseRef>& occurrences(Literal lit) {
+        std::vector<ClauseRef>& list = occurs[occurrenceIndex(lit)];
+        list.erase(std::remove_if(list.begin(), list.end(), [&](ClauseRef ref) { return formula.deleted(ref); }), list.end());
+        return list;
+    }
+
+    // Resolvent of two sorted clauses on var; returns false for tautologies
+    bool resolve(ClauseRef pos, ClauseRef neg, int var) {
+        ClauseView first = formula[pos], second = formula[neg];
+        for (Literal lit : first) {
+            if (lit != var && std::binary_search(second.begin(), second.end(), -lit)) return false;
+        }
+        resolvent.clear();
+        std::set_union(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(resolvent));
+        resolvent.erase(std::remove_if(resolvent.begin(), resolvent.end(),
+                                       [&](Literal lit) { return std::abs(lit) == var; }), resolvent.end());
+        return true;
+    }
+
+    // Replaces the clauses of var by all their non-tautological resolvents. With bounded set the
+    // elimination is skipped if it would leave more clauses than it removes.
+    bool eliminate(int var, bool bounded) {
+        std::vector<ClauseRef> pos = occurrences(var);
+        std::vector<ClauseRef> neg = occurrences(-var);
+        size_t limit = bounded ? pos.size() + neg.size() : std::numeric_limits<size_t>::max();
+        generated.clear();
+        for (ClauseRef p : pos) {
+            for (ClauseRef n : neg) {
+                if (!resolve(p, n, var)) continue;
+                if (generated.numClauses() == limit) return false;
+                generated.add(resolvent);
+            }
+        }
+        eliminated[var] = true;
+        eliminatedVars++;
+        for (ClauseRef p : pos) removeClause(p, var);
+        for (ClauseRef n : neg) removeClause(n, -var);
+        for (ClauseView clause : generated) {
+            resolvent.assign(clause.begin(), clause.end());
+            addClause(resolvent);
+            resolvents++;
+        }
+        // Erased clauses linger in the arena; rebuild once they outnumber the live ones
+        if (formula.size() > 2 * liveClauses + 1024) compact();
+        return true;
+    }
+
+    // Eliminates variables, cheapest first, until the queue runs dry or the empty clause appears
+    void run(bool bounded) {
+        for (int var = 1; var < static_cast<int>(eliminated.size()); ++var) touch(var);
+        while (!queue.empty() && !unsat) {
+            std::pair<long long, int> top = queue.top();
+            queue.pop();
+            int var = top.second;
+            if (eliminated[var] || top.first != cost(var)) continue;
+            if (count[occurrenceIndex(var)] == 0 && count[occurrenceIndex(-var)] == 0) continue;
+            eliminate(var, bounded);
+        }
+    }
+
+    void compact() {
+        ClauseSet live;
+        live.reserve(liveClauses, formula.arena.literals.size());
+        live.declareVars(formula.arena.numVars);
+        std::vector<Literal> clause;
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(formula.size()); ++ref) {
+            if (formula.deleted(ref)) continue;
+            clause.assign(formula[ref].begin(), formula[ref].end());
+            live.insert(clause);
+        }
+        formula = std::move(live);
+        for (std::vector<ClauseRef>& list : occurs) list.clear();
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(formula.size()); ++ref) {
+            for (Literal lit : formula[ref]) occurs[occurrenceIndex(lit)].push_back(ref);
+        }
+    }
+
+    ClauseArena remaining() const {
+        ClauseArena result;
+        result.declareVars(formula.arena.numVars);
+        if (unsat) {
+            result.add(nullptr, 0);
+            return result;
+        }
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(formula.size()); ++ref) {
+            if (!formula.deleted(ref)) result.add(formula[ref].begin(), formula[ref].size());
+        }
+        return result;
+    }
+};
+
+// Bounded variable elimination as a preprocessing step: only eliminations that do not grow the
+// clause count are performed. Removed clauses go to stack for model reconstruction.
+inline ClauseArena eliminateVariables(const ClauseArena& formula, EliminationStack& stack, PreprocessStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    Eliminator eliminator(formula, &stack);
+    eliminator.run(true);
+    ClauseArena result = eliminator.remaining();
+    stats.clausesRemoved += formula.numClauses() - result.numClauses();
+    stats.varsRemoved += countVariables(formula) - countVariables(result);
+    stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "clause_arena.h"
+#include "dimacs.h"
+#include "options.h"
+#include "preprocess.h"
+#include "elimination.h"
+#include "probing.h"
+#include "solver.h"
+#include "symmetry.h"
+#include "watched_formula.h"
+#include "stats.h"
+
+// Input side shared by the solver binaries: reads the formula, runs the simplifications the
+// options ask for and keeps what is needed to turn a model of the result into one of the input
+struct Frontend {
+    const SolverOptions& options;
+    PreprocessStats stats;
+    std::vector<Literal> pureLiterals;
+    EliminationStack eliminationStack;
+    Substitution substitution;
+    int symmetryVars = 0;  // variables before the auxiliary ones of the symmetry-breaking clauses
+    double parseSeconds = 0.0;
+
+    explicit Frontend(const SolverOptions& options) : options(options) {}
+
+    bool load(ClauseArena& formula) {
+        {
+            ScopedTimer timer(parseSeconds);
+            if (!readDimacs(options.input, formula)) return false;
+        }
+        simplify(formula);
+        return true;
+    }
+
+    // The simplifications alone, for formulas read by the caller
+    void simplify(ClauseArena& formula) {
+        if (options.preprocess) formula = preprocess(formula, pureLiterals, stats);
+        if (options.eliminate) formula = eliminateVariables(formula, eliminationStack, stats);
+        if (options.probe) formula = probeBinaryImplications(formula, substitution, stats);
+        if (options.symmetry) {
+            symmetryVars = formula.numVars;
+            formula = breakSymmetries(formula, stats);
+        }
+    }
+
+    void extendModel(Assignment& assignment) const {
+        if (options.symmetry) assignment.truncate(symmetryVars);
+        if (options.probe) substitution.extendModel(assignment);
+        if (options.eliminate) eliminationStack.extendModel(assignment);
+        // Clauses removed with a pure literal are satisfied by making it true
+        for (Literal lit : pureLiterals) assignment.assign(lit);
+    }
+
+    void printStats() const {
+        if (options.timers) std::cout << "Parsing Time: " << parseSeconds << "s" << std::endl;
+        if (options.probe) {
+            std::cout << "Equivalent Variables: " << stats.equivalentVars << std::endl;
+            std::cout << "Failed Literals: " << stats.failedLiterals << std::endl;
+        }
+        if (options.symmetry) {
+            std::cout << "Symmetry Generators: " << stats.symmetryGenerators << std::endl;
+            std::cout << "Symmetry Breaking Clauses: " << stats.symmetryClauses << std::endl;
+        }
+        if (options.preprocess || options.eliminate || options.probe || options.symmetry) printPreprocessStats(stats);
+        else if (options.timers) std::cout << "Preprocessing Time: 0s" << std::endl;
+    }
+};
+
+inline void printAssignment(const Assignment& assignment) {
+    std::cout << "Assignment: ";
+    for (int var = 1; var <= assignment.numVars(); ++var) {
+        if (assignment.assigned(var)) std::cout << var << "=" << static_cast<int>(assignment.value(var)) << " ";
+    }
+    std::cout << std::endl;
+}
+
+// Main function of the per-algorithm binaries, which differ only in config: reads and simplifies
+// the input, solves it under a StatsMonitor and prints the result, the model, the statistics,
+// the time of the search alone and the preprocessing report
+inline int solveAndReport(const SolverOptions& options, const SolverConfig& config) {
+    Frontend frontend(options);
+    ClauseArena formula;
+    if (!frontend.load(formula)) return 1;
+    std::unique_ptr<Solver> solver = makeSolver(config);
+
+    StatsMonitor monitor(options.progress);
+    monitor.watch(algorithmName(config.algorithm), solver->stats());
+    monitor.start();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    SolveResult result = solver->solve(formula);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    monitor.stop();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    std::cout << resultName(result) << std::endl;
+    if (result == SolveResult::Satisfiable && solver->hasModel()) {
+        Assignment assignment = solver->model();
+        frontend.extendModel(assignment);
+        printAssignment(assignment);
+    }
+    printSolverStats(solver->stats(), config);
+    std::cout << "Solving time: " << elapsed_seconds.count() << "s" << std::endl;
+    frontend.printStats();
+    return 0;
+}
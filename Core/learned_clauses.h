@@ -0,0 +1,142 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include "clause_arena.h"
+
+// Learned clauses are kept in three tiers by literal block distance: core clauses (LBD <= 2) for
+// good, mid-tier clauses (LBD <= 6) as long as they keep taking part in conflicts, and local
+// clauses only while their activity is among the better half.
+enum class ClauseTier : unsigned char { Core, Mid, Local };
+
+struct LearnedInfo {
+    float activity = 0.0f;
+    int lbd = 0;
+    ClauseTier tier = ClauseTier::Local;
+    bool used = false;  // resolved on in conflict analysis since the last reduction
+};
+
+// Scores the learned clauses of a clause arena and decides which ones to delete. Reductions come
+// after a conflict budget that grows by intervalGrowth each time, and earlier whenever the learned
+// clauses take more than memoryLimit bytes; such a reduction also deletes mid-tier and core
+// clauses, weakest first, until they are back to three quarters of the limit.
+struct LearnedClauses {
+    static const int CORE_LBD = 2;
+    static const int MID_LBD = 6;
+
+    long long interval = 2000;      // conflicts before the first reduction
+    long long intervalGrowth = 300;
+    size_t memoryLimit = 0;         // 0 for no limit
+    float activityDecay = 0.999f;
+    std::vector<LearnedInfo> info;  // indexed by ClauseRef; entries of original clauses are unused
+    float activityIncrement = 1.0f;
+    long long nextReduce = 0;
+    long long lastReduce = 0;
+    long long reductions = 0;
+    size_t count = 0;     // learned clauses not deleted
+    size_t literals = 0;  // their total size
+
+    explicit LearnedClauses(size_t memoryLimit = 0) : memoryLimit(memoryLimit), nextReduce(interval) {}
+
+    static ClauseTier tierOf(int lbd) {
+        if (lbd <= CORE_LBD) return ClauseTier::Core;
+        if (lbd <= MID_LBD) return ClauseTier::Mid;
+        return ClauseTier::Local;
+    }
+
+    // Literals, header, scores and the two watches of every learned clause
+    size_t bytes() const {
+        return literals * sizeof(Literal) + count * (sizeof(ClauseHeader) + sizeof(LearnedInfo) + 2 * sizeof(int));
+    }
+
+    // Back to an empty database, keeping the configuration
+    void reset() {
+        info.clear();
+        activityIncrement = 1.0f;
+        nextReduce = interval;
+        lastReduce = 0;
+        reductions = 0;
+        count = 0;
+        literals = 0;
+    }
+
+    void add(ClauseRef ref, size_t size, int lbd) {
+        if (info.size() <= static_cast<size_t>(ref)) info.resize(ref + 1);
+        info[ref] = {activityIncrement, lbd, tierOf(lbd), false};
+        count++;
+        literals += size;
+    }
+
+    void bump(ClauseRef ref) {
+        info[ref].used = true;
+        info[ref].activity += activityIncrement;
+        if (info[ref].activity > 1e20f) {
+            for (LearnedInfo& clause : info) clause.activity *= 1e-20f;
+            activityIncrement *= 1e-20f;
+        }
+    }
+
+    // A clause whose LBD dropped since it was learned moves up to the tier of its new LBD
+    void updateLbd(ClauseRef ref, int lbd) {
+        LearnedInfo& clause = info[ref];
+        if (lbd >= clause.lbd) return;
+        clause.lbd = lbd;
+        clause.tier = std::min(clause.tier, tierOf(lbd));
+    }
+
+    void decayActivities() {
+        activityIncrement /= activityDecay;
+    }
+
+    // Over the memory limit, once per conflict at most
+    bool due(long long conflicts) const {
+        return conflicts >= nextReduce || (memoryLimit > 0 && bytes() > memoryLimit && conflicts > lastReduce);
+    }
+
+    // Marks the clauses to drop as deleted in arena and returns how many there were. Mid-tier
+    // clauses unused since the last reduction are demoted to local first. locked(ref) must be true
+    // for clauses that are the reason of a current assignment; those are never deleted.
+    template <typename Locked>
+    size_t reduce(ClauseArena& arena, long long conflicts, Locked locked) {
+        reductions++;
+        lastReduce = conflicts;
+        nextReduce = conflicts + interval + reductions * intervalGrowth;
+        std::vector<ClauseRef> candidates;
+        size_t local = 0;
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(info.size()); ++ref) {
+            if (!(arena.headers[ref].flags & CLAUSE_LEARNED) || arena.deleted(ref)) continue;
+            LearnedInfo& clause = info[ref];
+            if (clause.tier == ClauseTier::Mid && !clause.used) clause.tier = ClauseTier::Local;
+            clause.used = false;
+            if (locked(ref)) continue;
+            candidates.push_back(ref);
+            if (clause.tier == ClauseTier::Local) local++;
+        }
+        std::sort(candidates.begin(), candidates.end(), [&](ClauseRef a, ClauseRef b) {
+            if (info[a].tier != info[b].tier) return info[a].tier > info[b].tier;
+            return info[a].activity < info[b].activity;
+        });
+        size_t removed = 0;
+        for (ClauseRef ref : candidates) {
+            bool overBudget = memoryLimit > 0 && bytes() > memoryLimit / 4 * 3;
+            if (removed >= local / 2 && !overBudget) break;
+            arena.markDeleted(ref);
+            count--;
+            literals -= arena.size(ref);
+            removed++;
+        }
+        return removed;
+    }
+
+    // Follows ClauseArena::compact
+    void compact(const std::vector<ClauseRef>& remap) {
+        size_t kept = 0;
+        for (size_t ref = 0; ref < info.size(); ++ref) {
+            if (remap[ref] < 0) continue;
+            info[remap[ref]] = info[ref];
+            kept = remap[ref] + 1;
+        }
+        info.resize(kept);
+    }
+};
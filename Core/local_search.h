@@ -0,0 +1,265 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include "clause_arena.h"
+#include "watched_formula.h"
+
+enum class WalkStrategy { WalkSAT, ProbSAT };
+
+struct LocalSearchConfig {
+    WalkStrategy strategy = WalkStrategy::ProbSAT;
+    // WalkSAT: probability of a random walk step (default 0.567); probSAT: exponent cb of the
+    // (0.9 + break)^-cb flip weights (default 2.06). 0 picks the default.
+    double noise = 0.0;
+    long long maxFlips = 0;  // 0 for no limit, or for the default budget if timeLimit is 0 too
+    double timeLimit = 0.0;  // seconds, 0 for no limit
+};
+
+// Flip budgets when the configuration sets neither flips nor time: a warm start only seeds the
+// phases, while a search on its own needs more room but must still end on unsatisfiable formulas
+const long long WARM_START_FLIPS = 1000000;
+const long long SEARCH_FLIPS = 100000000;
+
+inline long long flipBudget(const LocalSearchConfig& config, long long fallback) {
+    return config.maxFlips == 0 && config.timeLimit == 0.0 ? fallback : config.maxFlips;
+}
+
+// Stochastic local search over complete assignments. Every step takes a random unsatisfied
+// clause and flips one of its variables, chosen from the break counts (how many clauses would
+// turn unsatisfied). WalkSAT flips a variable that breaks nothing if there is one, else a random
+// one with probability noise and a least-breaking one otherwise; probSAT picks each variable with
+// probability proportional to (0.9 + break)^-cb. Break counts are kept up to date on every flip through
+// the true-literal count and the one true variable of each clause, and the unsatisfied clauses
+// sit in a dense list with a position index, so adding and removing are O(1).
+struct LocalSearch {
+    std::vector<Literal> literals;         // clauses back to back, duplicate literals dropped
+    std::vector<size_t> start;             // clause c is literals[start[c]] to literals[start[c + 1]]
+    std::vector<int> occurs;               // clauses of each literal, grouped by watchIndex
+    std::vector<size_t> occursStart;       // lit i = watchIndex(lit) owns occurs[occursStart[i]] up to occursStart[i + 1]
+    std::vector<signed char> value;        // 1 for true, by variable
+    std::vector<signed char> best;         // assignment with the fewest unsatisfied clauses so far
+    std::vector<int> changed;              // variables flipped since best was last brought up to date
+    std::vector<bool> isChanged;
+    std::vector<int> numTrue;
+    std::vector<int> critical;  // the true variable of clauses with exactly one true literal
+    std::vector<int> breaks;
+    std::vector<int> unsat;
+    std::vector<int> unsatPosition;  // index in unsat, -1 for satisfied clauses
+    std::vector<double> probability;  // probSAT: flip weight by break count
+    std::vector<double> weights;
+    WalkStrategy strategy;
+    double noise;
+    uint32_t walkThreshold = 0;  // WalkSAT: noise scaled to the range of rng, which draws are compared with
+    std::mt19937 rng;
+    int numVars;
+    size_t bestUnsat = 0;
+    long long flips = 0;
+    bool hasEmptyClause = false;
+
+    LocalSearch(const ClauseArena& formula, const LocalSearchConfig& config, unsigned seed)
+        : occursStart(2 * formula.numVars + 3, 0), strategy(config.strategy), noise(config.noise), rng(seed),
+          numVars(formula.numVars) {
+        if (noise <= 0.0) noise = strategy == WalkStrategy::WalkSAT ? 0.567 : 2.06;
+        walkThreshold = static_cast<uint32_t>(std::min(noise, 1.0) * 4294967295.0);
+        if (strategy == WalkStrategy::ProbSAT) {
+            for (int b = 0; b < 64; ++b) probability.push_back(std::pow(0.9 + b, -noise));
+        }
+        start.push_back(0);
+        for (ClauseView clause : formula) {
+            size_t first = literals.size();
+            bool tautology = false;
+            for (Literal lit : clause) {
+                auto begin = literals.begin() + first;
+                if (std::find(begin, literals.end(), -lit) != literals.end()) tautology = true;
+                if (std::find(begin, literals.end(), lit) == literals.end()) literals.push_back(lit);
+            }
+            if (tautology) {
+                literals.resize(first);
+                continue;
+            }
+            if (literals.size() == first) hasEmptyClause = true;
+            for (size_t i = first; i < literals.size(); ++i) occursStart[watchIndex(literals[i]) + 1]++;
+            start.push_back(literals.size());
+        }
+        for (size_t i = 1; i < occursStart.size(); ++i) occursStart[i] += occursStart[i - 1];
+        occurs.resize(literals.size());
+        std::vector<size_t> fill(occursStart.begin(), occursStart.end() - 1);
+        for (size_t c = 0; c < numClauses(); ++c) {
+            for (size_t i = start[c]; i < start[c + 1]; ++i) occurs[fill[watchIndex(literals[i])]++] = static_cast<int>(c);
+        }
+    }
+
+    size_t numClauses() const { return start.size() - 1; }
+
+    bool isTrue(Literal lit) const { return (value[std::abs(lit)] != 0) == (lit > 0); }
+
+    // Starts from phases (1 for true, by variable) or, without them, from a random assignment
+    void initialize(const std::vector<signed char>* phases = nullptr) {
+        value.assign(numVars + 1, 0);
+        for (int var = 1; var <= numVars; ++var) {
+            value[var] = phases ? (*phases)[var] : static_cast<signed char>(rng() & 1);
+        }
+        numTrue.assign(numClauses(), 0);
+        critical.assign(numClauses(), 0);
+        breaks.assign(numVars + 1, 0);
+        unsat.clear();
+        unsatPosition.assign(numClauses(), -1);
+        for (size_t c = 0; c < numClauses(); ++c) {
+            for (size_t i = start[c]; i < start[c + 1]; ++i) {
+                if (!isTrue(literals[i])) continue;
+                numTrue[c]++;
+                critical[c] = std::abs(literals[i]);
+            }
+            if (numTrue[c] == 0) addUnsat(static_cast<int>(c));
+            if (numTrue[c] == 1) breaks[critical[c]]++;
+        }
+        best = value;
+        bestUnsat = unsat.size();
+        changed.clear();
+        isChanged.assign(numVars + 1, false);
+    }
+
+    // Flips until every clause is satisfied (true) or the budget runs out (false)
+    bool run(long long maxFlips, double timeLimit, const std::atomic<bool>* stop) {
+        auto begin = std::chrono::steady_clock::now();
+        for (long long step = 0; !unsat.empty(); ++step) {
+            if (maxFlips > 0 && step >= maxFlips) return false;
+            if ((step & 1023) == 0) {
+                if (stop && stop->load(std::memory_order_relaxed)) return false;
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+                if (timeLimit > 0.0 && elapsed.count() >= timeLimit) return false;
+            }
+            int clause = unsat[rng() % unsat.size()];
+            int var = strategy == WalkStrategy::WalkSAT ? pickWalkSat(clause) : pickProbSat(clause);
+            flip(var);
+            if (!isChanged[var]) {
+                isChanged[var] = true;
+                changed.push_back(var);
+            }
+            if (unsat.size() < bestUnsat) updateBest();
+        }
+        return true;
+    }
+
+    // Makes the current assignment the best one, copying only the variables flipped since the last
+    // improvement rather than the whole assignment
+    void updateBest() {
+        bestUnsat = unsat.size();
+        for (int var : changed) {
+            best[var] = value[var];
+            isChanged[var] = false;
+        }
+        changed.clear();
+    }
+
+    void flip(int var) {
+        flips++;
+        value[var] = !value[var];
+        Literal madeTrue = value[var] ? var : -var;
+        for (size_t k = occursStart[watchIndex(madeTrue)]; k < occursStart[watchIndex(madeTrue) + 1]; ++k) {
+            int c = occurs[k];
+            if (numTrue[c] == 0) {
+                removeUnsat(c);
+                critical[c] = var;
+                breaks[var]++;
+            } else if (numTrue[c] == 1) {
+                breaks[critical[c]]--;
+            }
+            numTrue[c]++;
+        }
+        for (size_t k = occursStart[watchIndex(-madeTrue)]; k < occursStart[watchIndex(-madeTrue) + 1]; ++k) {
+            int c = occurs[k];
+            numTrue[c]--;
+            if (numTrue[c] == 0) {
+                addUnsat(c);
+                breaks[var]--;
+            } else if (numTrue[c] == 1) {
+                for (size_t i = start[c]; i < start[c + 1]; ++i) {
+                    if (isTrue(literals[i])) {
+                        critical[c] = std::abs(literals[i]);
+                        break;
+                    }
+                }
+                breaks[critical[c]]++;
+            }
+        }
+    }
+
+    int pickWalkSat(int clause) {
+        size_t size = start[clause + 1] - start[clause];
+        const Literal* lits = literals.data() + start[clause];
+        int chosen = 0;
+        int fewest = 0;
+        int ties = 0;
+        for (size_t i = 0; i < size; ++i) {
+            int b = breaks[std::abs(lits[i])];
+            if (ties == 0 || b < fewest) {
+                fewest = b;
+                ties = 0;
+            }
+            // Reservoir sampling among the least-breaking variables
+            if (b == fewest && rng() % ++ties == 0) chosen = std::abs(lits[i]);
+        }
+        if (fewest > 0 && rng() < walkThreshold) {
+            return std::abs(lits[rng() % size]);
+        }
+        return chosen;
+    }
+
+    int pickProbSat(int clause) {
+        size_t size = start[clause + 1] - start[clause];
+        const Literal* lits = literals.data() + start[clause];
+        weights.resize(size);
+        double total = 0.0;
+        for (size_t i = 0; i < size; ++i) {
+            int b = std::min(breaks[std::abs(lits[i])], 63);
+            total += probability[b];
+            weights[i] = total;
+        }
+        double r = rng() * (total / 4294967296.0);
+        for (size_t i = 0; i + 1 < size; ++i) {
+            if (r < weights[i]) return std::abs(lits[i]);
+        }
+        return std::abs(lits[size - 1]);
+    }
+
+    // The assignment to report: the current one once solved, else the best one seen
+    void model(Assignment& assignment) const {
+        const std::vector<signed char>& values = unsat.empty() ? value : best;
+        assignment.reset(numVars);
+        for (int var = 1; var <= numVars; ++var) assignment.assign(values[var] ? var : -var);
+    }
+
+private:
+    void addUnsat(int c) {
+        unsatPosition[c] = static_cast<int>(unsat.size());
+        unsat.push_back(c);
+    }
+
+    void removeUnsat(int c) {
+        int last = unsat.back();
+        unsat[unsatPosition[c]] = last;
+        unsatPosition[last] = unsatPosition[c];
+        unsat.pop_back();
+        unsatPosition[c] = -1;
+    }
+};
+
+// Warm start of the systematic solvers: a local search run whose best assignment becomes their
+// initial phases (1 for true, by variable). Returns the number of flips made.
+inline long long warmStartPhases(const ClauseArena& formula, const LocalSearchConfig& config, unsigned seed,
+                                 const std::atomic<bool>* stop, std::vector<signed char>& phase) {
+    LocalSearch search(formula, config, seed);
+    if (search.hasEmptyClause) return 0;
+    search.initialize();
+    search.run(flipBudget(config, WARM_START_FLIPS), config.timeLimit, stop);
+    const std::vector<signed char>& values = search.unsat.empty() ? search.value : search.best;
+    if (phase.size() < values.size()) phase.resize(values.size(), 1);
+    std::copy(values.begin() + 1, values.end(), phase.begin() + 1);
+    return search.flips;
+}
@@ -0,0 +1,29 @@
+#include "solver.h"
+
+// Local search on its own: Satisfiable with a model when it finds one, Unknown when the flip or
+// time budget (SEARCH_FLIPS flips if neither is set) runs out or stop is raised. An empty clause
+// is the only unsatisfiability it detects.
+class LocalSearchSolver : public Solver {
+public:
+    explicit LocalSearchSolver(const SolverConfig& config) : config(config.localSearch), seed(config.seed) {}
+
+    bool hasModel() const override { return true; }
+
+    SolveResult solve(const ClauseArena& formula) override {
+        LocalSearch search(formula, config, seed);
+        if (search.hasEmptyClause) return SolveResult::Unsatisfiable;
+        search.initialize();
+        bool found = search.run(flipBudget(config, SEARCH_FLIPS), config.timeLimit, stop);
+        counters.flips += search.flips;
+        search.model(assignment);
+        return found ? SolveResult::Satisfiable : SolveResult::Unknown;
+    }
+
+private:
+    LocalSearchConfig config;
+    unsigned seed;
+};
+
+std::unique_ptr<Solver> makeLocalSearchSolver(const SolverConfig& config) {
+    return std::make_unique<LocalSearchSolver>(config);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+// Command line shared by the solver binaries:
+// [--preprocess] [--eliminate] [--probe] [--symmetry] [--threads N] [--seed N] [--algorithm NAME] [--heuristic NAME]
+// [--restarts NAME] [--learned-memory MB] [--assume LITERALS] [--walk NAME] [--noise X] [--flips N]
+// [--time-limit SECONDS] [--warm-start] [--progress SECONDS] [--timers] [--batch] [input]
+struct SolverOptions {
+    const char* input = nullptr;  // null reads stdin
+    bool preprocess = false;
+    bool eliminate = false;  // bounded variable elimination before solving
+    bool probe = false;      // equivalent-literal substitution and failed-literal probing before solving
+    bool symmetry = false;   // lex-leader symmetry-breaking clauses before solving
+    unsigned threads = 0;    // parallel solvers only; 0 uses one thread per core
+    unsigned seed = 1;
+    const char* algorithm = nullptr;  // single CLI only: resolution, dp, dpll (default), cdcl or local
+    const char* heuristic = nullptr;  // DPLL branching: first (default), static, jw, moms, dynamic, vsids or random
+    const char* restarts = nullptr;   // DPLL and CDCL: none (default), luby, geometric or lbd
+    size_t learnedMemory = 0;         // CDCL: megabytes of learned clauses to stay within, 0 for no limit
+    const char* assume = nullptr;     // single CLI only: literals held true for the solve, e.g. "1 -3"
+    const char* walk = nullptr;       // local search: probsat (default) or walksat
+    double noise = 0.0;               // local search: walk probability or probSAT base, 0 for the default
+    long long flips = 0;              // local search flip budget, 0 for the default
+    double timeLimit = 0.0;           // local search time budget in seconds, 0 for none
+    bool warmStart = false;           // DPLL and CDCL: initial phases from a local search run
+    double progress = 0.0;            // seconds between progress lines on stderr, 0 for none
+    bool timers = false;              // report parsing and preprocessing times
+    bool batch = false;               // single CLI only: solve every formula of a stream or directory
+};
+
+inline bool parseOptions(int argc, char* argv[], SolverOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--preprocess") == 0) {
+            options.preprocess = true;
+        } else if (std::strcmp(argv[i], "--eliminate") == 0) {
+            options.eliminate = true;
+        } else if (std::strcmp(argv[i], "--probe") == 0) {
+            options.probe = true;
+        } else if (std::strcmp(argv[i], "--symmetry") == 0) {
+            options.symmetry = true;
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+            options.algorithm = argv[++i];
+        } else if (std::strcmp(argv[i], "--heuristic") == 0 && i + 1 < argc) {
+            options.heuristic = argv[++i];
+        } else if (std::strcmp(argv[i], "--restarts") == 0 && i + 1 < argc) {
+            options.restarts = argv[++i];
+        } else if (std::strcmp(argv[i], "--learned-memory") == 0 && i + 1 < argc) {
+            options.learnedMemory = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--assume") == 0 && i + 1 < argc) {
+            options.assume = argv[++i];
+        } else if (std::strcmp(argv[i], "--walk") == 0 && i + 1 < argc) {
+            options.walk = argv[++i];
+        } else if (std::strcmp(argv[i], "--noise") == 0 && i + 1 < argc) {
+            options.noise = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--flips") == 0 && i + 1 < argc) {
+            options.flips = std::strtoll(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc) {
+            options.timeLimit = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--warm-start") == 0) {
+            options.warmStart = true;
+        } else if (std::strcmp(argv[i], "--progress") == 0 && i + 1 < argc) {
+            options.progress = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--timers") == 0) {
+            options.timers = true;
+        } else if (std::strcmp(argv[i], "--batch") == 0) {
+            options.batch = true;
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            std::cerr << "Unknown option " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0] << " [--preprocess] [--eliminate] [--probe] [--symmetry] [--threads N]"
+                      << " [--seed N] [--algorithm NAME] [--heuristic NAME]"
+                      << " [--restarts NAME] [--learned-memory MB] [--assume LITERALS]"
+                      << " [--walk NAME] [--noise X] [--flips N] [--time-limit SECONDS] [--warm-start]"
+                      << " [--progress SECONDS] [--timers] [--batch] [input.cnf]" << std::endl;
+            return false;
+        } else {
+            options.input = argv[i];
+        }
+    }
+    return true;
+}
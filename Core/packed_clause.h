@@ -0,0 +1,179 @@
+#pragma once
+
+#include <vector>
+#include <bitset>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include "clause_arena.h"
+
+// Variable count up to which Resolution and DP work on packed clauses
+const int PACKED_MAX_VARS = 256;
+
+inline int lowestBit(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+inline int highestBit(uint64_t word) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(word);
+#else
+    int bit = 63;
+    while (!(word >> bit)) bit--;
+    return bit;
+#endif
+}
+
+// Clauses as bitsets over the variables: `words` words of positive literals followed by `words`
+// words of negative literals, bit v standing for v or -v. Resolvents, tautology and subset tests
+// are word-wise OR and AND, and duplicates are looked up by hashing the words. Only worth it for
+// few variables, where a clause fits in a handful of words. Pointers into the store are
+// invalidated by insert(), references are not.
+struct PackedClauses {
+    size_t words;  // per polarity
+    std::vector<uint64_t> bits;
+    std::vector<uint32_t> sizes;
+    std::vector<bool> erased;
+    std::vector<ClauseRef> table;  // -1 marks an empty slot
+
+    explicit PackedClauses(int numVars) : words(static_cast<size_t>(numVars) / 64 + 1) {}
+
+    size_t stride() const { return 2 * words; }
+    size_t numClauses() const { return sizes.size(); }
+    size_t size(ClauseRef ref) const { return sizes[ref]; }
+    const uint64_t* operator[](ClauseRef ref) const { return bits.data() + stride() * ref; }
+
+    // Erased clauses stay in the table as tombstones until compact()
+    void erase(ClauseRef ref) { erased[ref] = true; }
+    bool deleted(ClauseRef ref) const { return erased[ref]; }
+
+    // out must hold stride() words
+    void pack(const Literal* lits, size_t size, uint64_t* out) const {
+        std::fill(out, out + stride(), 0);
+        for (size_t i = 0; i < size; ++i) {
+            int var = std::abs(lits[i]);
+            out[(lits[i] > 0 ? 0 : words) + var / 64] |= 1ULL << (var % 64);
+        }
+    }
+
+    bool tautology(const uint64_t* clause) const {
+        for (size_t w = 0; w < words; ++w) {
+            if (clause[w] & clause[words + w]) return true;
+        }
+        return false;
+    }
+
+    // Is every literal of a also one of b? Branch-free over the words, which vectorizes.
+    bool subset(const uint64_t* a, const uint64_t* b) const {
+        uint64_t extra = 0;
+        for (size_t w = 0; w < stride(); ++w) extra |= a[w] & ~b[w];
+        return extra == 0;
+    }
+
+    // Resolvent of a and b on var into out; returns false for tautologies
+    bool resolve(const uint64_t* a, const uint64_t* b, int var, uint64_t* out) const {
+        for (size_t w = 0; w < stride(); ++w) out[w] = a[w] | b[w];
+        uint64_t mask = ~(1ULL << (var % 64));
+        out[var / 64] &= mask;
+        out[words + var / 64] &= mask;
+        return !tautology(out);
+    }
+
+    size_t count(const uint64_t* clause) const {
+        size_t total = 0;
+        for (size_t w = 0; w < stride(); ++w) total += std::bitset<64>(clause[w]).count();
+        return total;
+    }
+
+    // Calls f on every literal of clause in increasing order, as they appear in a sorted clause
+    template <typename F>
+    void forEachLiteral(const uint64_t* clause, F f) const {
+        for (size_t w = words; w-- > 0;) {
+            for (uint64_t word = clause[words + w]; word != 0;) {
+                int bit = highestBit(word);
+                word &= ~(1ULL << bit);
+                f(-static_cast<Literal>(64 * w + bit));
+            }
+        }
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t word = clause[w]; word != 0; word &= word - 1) {
+                f(static_cast<Literal>(64 * w + lowestBit(word)));
+            }
+        }
+    }
+
+    void literals(ClauseRef ref, std::vector<Literal>& out) const {
+        out.clear();
+        forEachLiteral((*this)[ref], [&](Literal lit) { out.push_back(lit); });
+    }
+
+    // Live clause equal to clause, or -1
+    ClauseRef find(const uint64_t* clause) const {
+        if (table.empty()) return -1;
+        size_t mask = table.size() - 1;
+        for (size_t slot = hash(clause) & mask; table[slot] >= 0; slot = (slot + 1) & mask) {
+            if (!erased[table[slot]] && std::equal(clause, clause + stride(), (*this)[table[slot]])) return table[slot];
+        }
+        return -1;
+    }
+
+    // Stores clause unless a live copy is already there; returns the new reference or -1
+    ClauseRef insert(const uint64_t* clause) {
+        if (find(clause) >= 0) return -1;
+        if (2 * (numClauses() + 1) > table.size()) grow();
+        ClauseRef ref = static_cast<ClauseRef>(numClauses());
+        sizes.push_back(static_cast<uint32_t>(count(clause)));
+        erased.push_back(false);
+        bits.insert(bits.end(), clause, clause + stride());
+        place(ref);
+        return ref;
+    }
+
+    // Drops erased clauses; remap[old] is the new reference of each clause, -1 for erased ones
+    void compact(std::vector<ClauseRef>& remap) {
+        remap.assign(numClauses(), -1);
+        size_t kept = 0;
+        for (size_t ref = 0; ref < numClauses(); ++ref) {
+            if (erased[ref]) continue;
+            std::copy(bits.begin() + stride() * ref, bits.begin() + stride() * (ref + 1), bits.begin() + stride() * kept);
+            sizes[kept] = sizes[ref];
+            remap[ref] = static_cast<ClauseRef>(kept++);
+        }
+        bits.resize(stride() * kept);
+        sizes.resize(kept);
+        erased.assign(kept, false);
+        table.assign(table.size(), -1);
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(kept); ++ref) place(ref);
+    }
+
+private:
+    uint64_t hash(const uint64_t* clause) const {
+        uint64_t h = 1469598103934665603ULL;
+        for (size_t w = 0; w < stride(); ++w) {
+            h ^= clause[w];
+            h *= 1099511628211ULL;
+        }
+        return h ^ (h >> 29);
+    }
+
+    void place(ClauseRef ref) {
+        size_t mask = table.size() - 1;
+        size_t slot = hash((*this)[ref]) & mask;
+        while (table[slot] >= 0) slot = (slot + 1) & mask;
+        table[slot] = ref;
+    }
+
+    void grow() {
+        table.assign(table.empty() ? 16 : 2 * table.size(), -1);
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(numClauses()); ++ref) place(ref);
+    }
+};
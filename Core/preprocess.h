@@ -0,0 +1,240 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include "clause_arena.h"
+
+struct PreprocessStats {
+    size_t tautologies = 0;
+    size_t subsumed = 0;
+    size_t strengthened = 0;  // literals removed by self-subsuming resolution
+    size_t pureLiterals = 0;
+    size_t equivalentVars = 0;  // replaced by an equivalent literal
+    size_t failedLiterals = 0;
+    size_t symmetryGenerators = 0;
+    size_t symmetryClauses = 0;  // lex-leader clauses added for them
+    size_t clausesRemoved = 0;
+    size_t varsRemoved = 0;
+    double seconds = 0.0;
+};
+
+// Occurrence-list simplifier. Clauses are kept with sorted, unique literals; occurrence lists are
+// never pruned, so entries may point at deleted clauses or clauses that lost the literal since.
+struct Simplifier {
+    ClauseArena clauses;
+    std::vector<std::vector<ClauseRef>> occurs;  // indexed by occurrenceIndex(lit)
+    std::vector<uint64_t> signature;             // one bit per variable (mod 64) of each clause
+    std::vector<ClauseRef> queue;
+    std::vector<bool> queued;
+    bool unsat = false;
+    PreprocessStats& stats;
+
+    Simplifier(int numVars, PreprocessStats& stats) : occurs(2 * numVars + 2), stats(stats) {
+        clauses.declareVars(numVars);
+    }
+
+    static int occurrenceIndex(Literal lit) {
+        return lit > 0 ? 2 * lit : 2 * (-lit) + 1;
+    }
+
+    static uint64_t computeSignature(ClauseView clause) {
+        uint64_t sig = 0;
+        for (Literal lit : clause) sig |= 1ULL << (std::abs(lit) & 63);
+        return sig;
+    }
+
+    static bool contains(ClauseView clause, Literal lit) {
+        return std::binary_search(clause.begin(), clause.end(), lit);
+    }
+
+    // True if c subsumes d once at most one of its literals is negated; that literal is returned in
+    // flipped (0 for plain subsumption), and resolving on it lets -flipped be removed from d
+    bool subsumes(ClauseRef c, ClauseRef d, Literal& flipped) const {
+        ClauseView large = clauses[d];
+        flipped = 0;
+        for (Literal lit : clauses[c]) {
+            if (contains(large, lit)) continue;
+            if (flipped == 0 && contains(large, -lit)) {
+                flipped = lit;
+                continue;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    bool candidate(ClauseRef c, ClauseRef d) const {
+        return d != c && !clauses.deleted(d) && clauses.size(d) >= clauses.size(c) &&
+               (signature[c] & ~signature[d]) == 0;
+    }
+
+    // Drops tautologies, then forward subsumption: the clause is discarded if a clause loaded
+    // before it is a subset. Clauses are expected in order of increasing size.
+    void load(std::vector<Literal>& clause) {
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        for (Literal lit : clause) {
+            if (lit > 0 && std::binary_search(clause.begin(), clause.end(), -lit)) {
+                stats.tautologies++;
+                return;
+            }
+        }
+        if (clause.empty()) unsat = true;
+        ClauseRef ref = clauses.add(clause);
+        signature.push_back(computeSignature(clauses[ref]));
+        queued.push_back(false);
+        for (Literal lit : clause) {
+            for (ClauseRef other : occurs[occurrenceIndex(lit)]) {
+                Literal flipped;
+                if (candidate(other, ref) && subsumes(other, ref, flipped) && flipped == 0) {
+                    clauses.markDeleted(ref);
+                    stats.subsumed++;
+                    return;
+                }
+            }
+        }
+        for (Literal lit : clause) occurs[occurrenceIndex(lit)].push_back(ref);
+    }
+
+    void strengthen(ClauseRef ref, Literal lit) {
+        clauses.removeLiteral(ref, lit);
+        signature[ref] = computeSignature(clauses[ref]);
+        stats.strengthened++;
+        if (clauses.size(ref) == 0) unsat = true;
+        if (!queued[ref]) {
+            queued[ref] = true;
+            queue.push_back(ref);
+        }
+    }
+
+    // Backward subsumption and self-subsuming resolution: every clause removes the clauses it
+    // subsumes and strengthens the ones it subsumes with one literal negated. Strengthened
+    // clauses are requeued, since they may now subsume others.
+    void backwardSubsumption() {
+        for (ClauseRef ref = static_cast<ClauseRef>(clauses.numClauses()) - 1; ref >= 0; --ref) {
+            if (clauses.deleted(ref)) continue;
+            queued[ref] = true;
+            queue.push_back(ref);  // loaded by increasing size, so the shortest clauses pop first
+        }
+        while (!queue.empty() && !unsat) {
+            ClauseRef c = queue.back();
+            queue.pop_back();
+            queued[c] = false;
+            if (clauses.deleted(c)) continue;
+            // Every candidate contains the variable of c's least frequent literal
+            Literal best = 0;
+            size_t bestCount = 0;
+            for (Literal lit : clauses[c]) {
+                size_t count = occurs[occurrenceIndex(lit)].size() + occurs[occurrenceIndex(-lit)].size();
+                if (best == 0 || count < bestCount) {
+                    best = lit;
+                    bestCount = count;
+                }
+            }
+            if (best == 0) continue;
+            for (Literal lit : {best, -best}) {
+                for (ClauseRef d : occurs[occurrenceIndex(lit)]) {
+                    Literal flipped;
+                    if (!candidate(c, d) || !subsumes(c, d, flipped)) continue;
+                    if (flipped == 0) {
+                        clauses.markDeleted(d);
+                        stats.subsumed++;
+                    } else {
+                        strengthen(d, -flipped);
+                    }
+                }
+            }
+        }
+    }
+
+    // Removes every clause containing a literal whose negation occurs nowhere; removing them can
+    // make further literals pure. Each pure literal is appended to pureLiterals.
+    void eliminatePureLiterals(std::vector<Literal>& pureLiterals) {
+        std::vector<int> count(occurs.size(), 0);
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(clauses.numClauses()); ++ref) {
+            if (clauses.deleted(ref)) continue;
+            for (Literal lit : clauses[ref]) count[occurrenceIndex(lit)]++;
+        }
+        std::vector<Literal> candidates;
+        for (int var = 1; var <= clauses.numVars; ++var) {
+            if (count[occurrenceIndex(var)] > 0 && count[occurrenceIndex(-var)] == 0) candidates.push_back(var);
+            if (count[occurrenceIndex(-var)] > 0 && count[occurrenceIndex(var)] == 0) candidates.push_back(-var);
+        }
+        while (!candidates.empty()) {
+            Literal pure = candidates.back();
+            candidates.pop_back();
+            if (count[occurrenceIndex(pure)] == 0) continue;
+            pureLiterals.push_back(pure);
+            stats.pureLiterals++;
+            for (ClauseRef ref : occurs[occurrenceIndex(pure)]) {
+                if (clauses.deleted(ref) || !contains(clauses[ref], pure)) continue;
+                clauses.markDeleted(ref);
+                for (Literal lit : clauses[ref]) {
+                    if (--count[occurrenceIndex(lit)] == 0 && count[occurrenceIndex(-lit)] > 0) {
+                        candidates.push_back(-lit);
+                    }
+                }
+            }
+        }
+    }
+};
+
+inline size_t countVariables(const ClauseArena& formula) {
+    std::vector<bool> seen(formula.numVars + 1, false);
+    size_t count = 0;
+    for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(formula.numClauses()); ++ref) {
+        if (formula.deleted(ref)) continue;
+        for (Literal lit : formula[ref]) {
+            if (!seen[std::abs(lit)]) {
+                seen[std::abs(lit)] = true;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+// Runs tautology removal, forward and backward subsumption, self-subsuming resolution and
+// pure-literal elimination. The result is equisatisfiable with formula; a model of it extends to
+// a model of formula by setting every literal in pureLiterals true.
+inline ClauseArena preprocess(const ClauseArena& formula, std::vector<Literal>& pureLiterals, PreprocessStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    Simplifier simplifier(formula.numVars, stats);
+    std::vector<ClauseRef> order;
+    for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(formula.numClauses()); ++ref) order.push_back(ref);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](ClauseRef a, ClauseRef b) { return formula.size(a) < formula.size(b); });
+    std::vector<Literal> clause;
+    for (ClauseRef ref : order) {
+        clause.assign(formula[ref].begin(), formula[ref].end());
+        simplifier.load(clause);
+        if (simplifier.unsat) break;
+    }
+    if (!simplifier.unsat) simplifier.backwardSubsumption();
+    if (!simplifier.unsat) simplifier.eliminatePureLiterals(pureLiterals);
+
+    ClauseArena result;
+    result.declareVars(formula.numVars);
+    if (simplifier.unsat) {
+        result.add(nullptr, 0);
+    } else {
+        for (ClauseRef ref = 0; ref < static_cast<ClauseRef>(simplifier.clauses.numClauses()); ++ref) {
+            if (simplifier.clauses.deleted(ref)) continue;
+            ClauseView kept = simplifier.clauses[ref];
+            result.add(kept.begin(), kept.size());
+        }
+    }
+    stats.clausesRemoved += formula.numClauses() - result.numClauses();
+    stats.varsRemoved += countVariables(formula) - countVariables(result);
+    stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+inline void printPreprocessStats(const PreprocessStats& stats) {
+    std::cout << "Preprocessing Removed Clauses: " << stats.clausesRemoved << std::endl;
+    std::cout << "Preprocessing Removed Variables: " << stats.varsRemoved << std::endl;
+    std::cout << "Preprocessing Time: " << stats.seconds << "s" << std::endl;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+#include <algorithm>
+#include "clause_arena.h"
+#include "preprocess.h"
+#include "watched_formula.h"
+
+// Watch list entries failed-literal probing may visit before it gives up on the remaining literals
+const long long PROBING_BUDGET = 20000000;
+
+// Variables replaced by an equivalent literal. Setting each from its representative turns a model
+// of the substituted formula into one of the original.
+struct Substitution {
+    std::vector<std::pair<int, Literal>> replaced;  // variable and the literal it is equal to
+
+    void extendModel(Assignment& assignment) const {
+        for (const auto& entry : replaced) {
+            int representative = std::abs(entry.second);
+            // A representative left open by the solver is free; any value will do
+            if (!assignment.assigned(representative)) assignment.assign(representative);
+            bool value = assignment.value(representative) == (entry.second > 0);
+            assignment.assign(value ? entry.first : -entry.first);
+        }
+    }
+};
+
+// Strongly connected components of the binary implication graph, whose nodes are the literals and
+// whose edges are -a -> b and -b -> a for every binary clause (a b). Literals of one component imply
+// each other, so they are all equal; each is mapped to the literal of the smallest variable in its
+// component, which makes the representative of -lit the negation of the representative of lit.
+// Tarjan's algorithm, with an explicit stack. Returns false if some literal is equal to its negation.
+inline bool equivalentLiterals(int numVars, const std::vector<std::vector<Literal>>& implies,
+                               std::vector<Literal>& representative) {
+    size_t nodes = 2 * static_cast<size_t>(numVars) + 2;
+    std::vector<int> index(nodes, -1), lowlink(nodes, 0), component(nodes, -1);
+    std::vector<bool> onStack(nodes, false);
+    std::vector<Literal> stack;
+    std::vector<std::pair<Literal, size_t>> calls;  // literal and its next outgoing edge
+    representative.assign(nodes, 0);
+    int counter = 0;
+    int components = 0;
+    auto visit = [&](Literal lit) {
+        int node = watchIndex(lit);
+        index[node] = lowlink[node] = counter++;
+        stack.push_back(lit);
+        onStack[node] = true;
+        calls.push_back({lit, 0});
+    };
+    for (int var = 1; var <= numVars; ++var) {
+        for (Literal root : {var, -var}) {
+            if (index[watchIndex(root)] >= 0) continue;
+            visit(root);
+            while (!calls.empty()) {
+                Literal lit = calls.back().first;
+                int node = watchIndex(lit);
+                const std::vector<Literal>& edges = implies[node];
+                if (calls.back().second < edges.size()) {
+                    Literal next = edges[calls.back().second++];
+                    if (index[watchIndex(next)] < 0) {
+                        visit(next);
+                    } else if (onStack[watchIndex(next)]) {
+                        lowlink[node] = std::min(lowlink[node], index[watchIndex(next)]);
+                    }
+                    continue;
+                }
+                calls.pop_back();
+                if (!calls.empty()) {
+                    int parent = watchIndex(calls.back().first);
+                    lowlink[parent] = std::min(lowlink[parent], lowlink[node]);
+                }
+                if (lowlink[node] != index[node]) continue;
+                size_t first = stack.size();
+                do {
+                    first--;
+                } while (stack[first] != lit);
+                Literal smallest = lit;
+                for (size_t k = first; k < stack.size(); ++k) {
+                    if (std::abs(stack[k]) < std::abs(smallest)) smallest = stack[k];
+                }
+                for (size_t k = first; k < stack.size(); ++k) {
+                    onStack[watchIndex(stack[k])] = false;
+                    component[watchIndex(stack[k])] = components;
+                    representative[watchIndex(stack[k])] = smallest;
+                }
+                stack.resize(first);
+                components++;
+            }
+        }
+    }
+    for (int var = 1; var <= numVars; ++var) {
+        if (component[watchIndex(var)] == component[watchIndex(-var)]) return false;
+    }
+    return true;
+}
+
+// Equivalent-literal substitution followed by failed-literal probing, both driven by the binary
+// clauses. Every variable is replaced by the representative of its component in the binary
+// implication graph (see equivalentLiterals), which removes the variable and can turn clauses into
+// tautologies or duplicates. Probing then assigns every literal whose negation occurs in a binary
+// clause, one at a time, and propagates; a literal whose propagation conflicts is failed, and its
+// negation is asserted for good. The result holds the clauses not satisfied by the asserted
+// literals, without their false literals, plus one unit clause per asserted literal. It is
+// equisatisfiable with formula, and substitution turns its models into models of formula.
+inline ClauseArena probeBinaryImplications(const ClauseArena& formula, Substitution& substitution, PreprocessStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    int numVars = formula.numVars;
+    ClauseArena result;
+    result.declareVars(numVars);
+    auto finish = [&](bool unsat) {
+        if (unsat) {
+            result.clear();
+            result.declareVars(numVars);
+            result.add(nullptr, 0);
+        }
+        // Unit clauses for the asserted literals may outnumber the clauses removed
+        if (result.numClauses() < formula.numClauses()) stats.clausesRemoved += formula.numClauses() - result.numClauses();
+        stats.varsRemoved += countVariables(formula) - countVariables(result);
+        stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    };
+
+    std::vector<std::vector<Literal>> implies(2 * static_cast<size_t>(numVars) + 2);
+    for (ClauseView clause : formula) {
+        if (clause.size() != 2 || clause[0] == clause[1]) continue;
+        implies[watchIndex(-clause[0])].push_back(clause[1]);
+        implies[watchIndex(-clause[1])].push_back(clause[0]);
+    }
+    std::vector<Literal> representative;
+    if (!equivalentLiterals(numVars, implies, representative)) return finish(true);
+    for (int var = 1; var <= numVars; ++var) {
+        if (representative[watchIndex(var)] != var) {
+            substitution.replaced.push_back({var, representative[watchIndex(var)]});
+            stats.equivalentVars++;
+        }
+    }
+
+    ClauseArena substituted;
+    substituted.declareVars(numVars);
+    Clause clause;
+    for (ClauseView input : formula) {
+        clause.clear();
+        bool tautology = false;
+        for (Literal lit : input) {
+            Literal mapped = representative[watchIndex(lit)];
+            if (std::find(clause.begin(), clause.end(), -mapped) != clause.end()) tautology = true;
+            if (std::find(clause.begin(), clause.end(), mapped) == clause.end()) clause.push_back(mapped);
+        }
+        if (!tautology) substituted.add(clause);
+    }
+
+    WatchedFormula wf = buildWatches(substituted);
+    Assignment assignment(numVars);
+    Trail trail;
+    auto propagateAll = [&]() {
+        return propagate(wf, assignment, trail, [&](Literal lit, int) { enqueue(assignment, trail, lit); }) < 0;
+    };
+    if (wf.hasEmptyClause) return finish(true);
+    for (Literal unit : wf.units) {
+        if (!enqueue(assignment, trail, unit)) return finish(true);
+    }
+    if (!propagateAll()) return finish(true);
+    for (int var = 1; var <= numVars && wf.visits < PROBING_BUDGET; ++var) {
+        for (Literal lit : {var, -var}) {
+            if (isAssigned(assignment, var) || wf.binaries[watchIndex(-lit)].empty()) continue;
+            newDecisionLevel(trail);
+            enqueue(assignment, trail, lit);
+            bool failed = !propagateAll();
+            backtrack(trail, assignment, 0);
+            if (!failed) continue;
+            stats.failedLiterals++;
+            enqueue(assignment, trail, -lit);
+            if (!propagateAll()) return finish(true);
+        }
+    }
+
+    for (Literal lit : trail.literals) result.add(&lit, 1);
+    for (ClauseView input : substituted) {
+        clause.clear();
+        bool satisfied = false;
+        for (Literal lit : input) {
+            if (isTrue(assignment, lit)) satisfied = true;
+            if (!isAssigned(assignment, std::abs(lit))) clause.push_back(lit);
+        }
+        if (!satisfied) result.add(clause);
+    }
+    return finish(false);
+}
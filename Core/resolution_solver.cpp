@@ -0,0 +1,213 @@
+#include <queue>
+#include <cstdint>
+#include "solver.h"
+#include "packed_clause.h"
+
+inline int occurrenceIndex(Literal lit) {
+    return lit > 0 ? 2 * lit : 2 * (-lit) + 1;
+}
+
+inline uint64_t signatureOf(const Clause& clause) {
+    uint64_t sig = 0;
+    for (Literal lit : clause) sig |= 1ULL << (std::abs(lit) & 63);
+    return sig;
+}
+
+// Given-clause saturation. Every kept clause is selected once, shortest first, and resolved only
+// against the clauses selected before it, so each pair is tried exactly once. Partners are found
+// through an occurrence index over the processed clauses, and a resolvent is dropped if a kept
+// clause already subsumes it.
+struct Saturation {
+    ClauseSet clauses;  // every kept clause, sorted so subset tests are linear merges; rejects duplicates
+    std::vector<uint64_t> signature;
+    std::vector<std::vector<ClauseRef>> processed;  // occurrence index of the processed clauses
+    std::vector<std::vector<ClauseRef>> kept;       // occurrence index of all kept clauses
+    std::priority_queue<std::pair<size_t, ClauseRef>, std::vector<std::pair<size_t, ClauseRef>>,
+                        std::greater<std::pair<size_t, ClauseRef>>> unprocessed;
+    Counter& resolvents;
+
+    Saturation(int numVars, Counter& resolvents)
+        : processed(2 * numVars + 2), kept(2 * numVars + 2), resolvents(resolvents) {
+        clauses.declareVars(numVars);
+    }
+
+    // Forward subsumption: is some kept clause other than self a subset of clause?
+    bool subsumed(const Clause& clause, uint64_t sig, ClauseRef self) const {
+        for (Literal lit : clause) {
+            for (ClauseRef ref : kept[occurrenceIndex(lit)]) {
+                if (ref == self || clauses.arena.size(ref) > clause.size() || (signature[ref] & ~sig) != 0) continue;
+                ClauseView other = clauses[ref];
+                if (std::includes(clause.begin(), clause.end(), other.begin(), other.end())) return true;
+            }
+        }
+        return false;
+    }
+
+    // Queues clause unless it is a tautology, a duplicate or subsumed
+    void add(Clause& clause) {
+        std::sort(clause.begin(), clause.end());
+        clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+        for (Literal lit : clause) {
+            if (lit > 0 && std::binary_search(clause.begin(), clause.end(), -lit)) return;
+        }
+        uint64_t sig = signatureOf(clause);
+        if (subsumed(clause, sig, -1) || !clauses.insert(clause)) return;
+        ClauseRef ref = static_cast<ClauseRef>(clauses.size()) - 1;
+        signature.push_back(sig);
+        for (Literal lit : clause) kept[occurrenceIndex(lit)].push_back(ref);
+        unprocessed.push({clause.size(), ref});
+    }
+
+    // Returns true once the empty clause is derived; stops early when stop is raised
+    bool saturate(const std::atomic<bool>* stop, bool& cancelled) {
+        Clause given, resolvent;
+        while (!unprocessed.empty()) {
+            if (stop && stop->load(std::memory_order_relaxed)) {
+                cancelled = true;
+                return false;
+            }
+            ClauseRef ref = unprocessed.top().second;
+            unprocessed.pop();
+            ClauseView view = clauses[ref];
+            given.assign(view.begin(), view.end());
+            // Clauses kept after this one was queued may subsume it by now
+            if (subsumed(given, signature[ref], ref)) continue;
+            for (Literal lit : given) {
+                std::vector<ClauseRef>& partners = processed[occurrenceIndex(-lit)];
+                // add() may grow the arena, so partner literals are read through fresh views
+                for (size_t i = 0; i < partners.size(); ++i) {
+                    ClauseView partner = clauses[partners[i]];
+                    resolvent.clear();
+                    std::set_union(given.begin(), given.end(), partner.begin(), partner.end(), std::back_inserter(resolvent));
+                    resolvent.erase(std::remove_if(resolvent.begin(), resolvent.end(),
+                                                   [&](Literal l) { return std::abs(l) == std::abs(lit); }), resolvent.end());
+                    resolvents++;
+                    if (resolvent.empty()) return true;  // Empty clause found, unsatisfiable
+                    add(resolvent);
+                }
+            }
+            for (Literal lit : given) processed[occurrenceIndex(lit)].push_back(ref);
+        }
+        return false;
+    }
+};
+
+// The same saturation over packed clauses, for formulas with at most PACKED_MAX_VARS variables.
+// It keeps and resolves the same clauses in the same order, so the resolvent count matches. For
+// subsumption each kept clause is copied into the list of one of its literals, the one with the
+// shortest list at the time, so a subset test is tried at most once per kept clause and runs over
+// consecutive words.
+struct PackedSaturation {
+    PackedClauses clauses;
+    std::vector<std::vector<ClauseRef>> processed;
+    std::vector<std::vector<uint64_t>> kept;  // packed kept clauses, by occurrenceIndex of one literal
+    std::priority_queue<std::pair<size_t, ClauseRef>, std::vector<std::pair<size_t, ClauseRef>>,
+                        std::greater<std::pair<size_t, ClauseRef>>> unprocessed;
+    Counter& resolvents;
+
+    PackedSaturation(int numVars, Counter& resolvents)
+        : clauses(numVars), processed(2 * numVars + 2), kept(2 * numVars + 2), resolvents(resolvents) {}
+
+    // Is a kept clause a subset of clause? With strict set, clause itself does not count; kept
+    // clauses are all distinct, so that is any other one.
+    bool subsumed(const uint64_t* clause, bool strict) const {
+        size_t stride = clauses.stride();
+        bool found = false;
+        clauses.forEachLiteral(clause, [&](Literal lit) {
+            if (found) return;
+            const std::vector<uint64_t>& list = kept[occurrenceIndex(lit)];
+            for (size_t offset = 0; offset < list.size(); offset += stride) {
+                const uint64_t* other = list.data() + offset;
+                if (clauses.subset(other, clause) && !(strict && std::equal(other, other + stride, clause))) {
+                    found = true;
+                    return;
+                }
+            }
+        });
+        return found;
+    }
+
+    void add(const uint64_t* clause) {
+        if (clauses.tautology(clause) || subsumed(clause, false)) return;
+        ClauseRef ref = clauses.insert(clause);
+        if (ref < 0) return;
+        int shortest = -1;
+        clauses.forEachLiteral(clauses[ref], [&](Literal lit) {
+            int index = occurrenceIndex(lit);
+            if (shortest < 0 || kept[index].size() < kept[shortest].size()) shortest = index;
+        });
+        if (shortest >= 0) kept[shortest].insert(kept[shortest].end(), clauses[ref], clauses[ref] + clauses.stride());
+        unprocessed.push({clauses.size(ref), ref});
+    }
+
+    bool saturate(const std::atomic<bool>* stop, bool& cancelled) {
+        std::vector<uint64_t> given(clauses.stride()), resolvent(clauses.stride());
+        Clause literals;
+        while (!unprocessed.empty()) {
+            if (stop && stop->load(std::memory_order_relaxed)) {
+                cancelled = true;
+                return false;
+            }
+            ClauseRef ref = unprocessed.top().second;
+            unprocessed.pop();
+            if (subsumed(clauses[ref], true)) continue;
+            std::copy(clauses[ref], clauses[ref] + clauses.stride(), given.begin());
+            clauses.literals(ref, literals);
+            for (Literal lit : literals) {
+                std::vector<ClauseRef>& partners = processed[occurrenceIndex(-lit)];
+                for (size_t i = 0; i < partners.size(); ++i) {
+                    clauses.resolve(given.data(), clauses[partners[i]], std::abs(lit), resolvent.data());
+                    resolvents++;
+                    if (clauses.count(resolvent.data()) == 0) return true;  // Empty clause found, unsatisfiable
+                    add(resolvent.data());
+                }
+            }
+            for (Literal lit : literals) processed[occurrenceIndex(lit)].push_back(ref);
+        }
+        return false;
+    }
+};
+
+// Saturation that ends without the empty clause means the formula is satisfiable, but no model
+// is built
+class ResolutionSolver : public Solver {
+public:
+    SolveResult solve(const ClauseArena& formula) override {
+        for (ClauseView view : formula) {
+            if (view.empty()) return SolveResult::Unsatisfiable;
+        }
+        if (formula.numVars <= PACKED_MAX_VARS) return run<PackedSaturation>(formula);
+        return run<Saturation>(formula);
+    }
+
+private:
+    template <typename Engine>
+    SolveResult run(const ClauseArena& formula) {
+        Engine saturation(formula.numVars, counters.resolvents);
+        add(saturation, formula);
+        bool cancelled = false;
+        bool refuted = saturation.saturate(stop, cancelled);
+        if (cancelled) return SolveResult::Unknown;
+        return refuted ? SolveResult::Unsatisfiable : SolveResult::Satisfiable;
+    }
+
+    static void add(Saturation& saturation, const ClauseArena& formula) {
+        Clause clause;
+        for (ClauseView view : formula) {
+            clause.assign(view.begin(), view.end());
+            saturation.add(clause);
+        }
+    }
+
+    static void add(PackedSaturation& saturation, const ClauseArena& formula) {
+        std::vector<uint64_t> clause(saturation.clauses.stride());
+        for (ClauseView view : formula) {
+            saturation.clauses.pack(view.begin(), view.size(), clause.data());
+            saturation.add(clause.data());
+        }
+    }
+};
+
+std::unique_ptr<Solver> makeResolutionSolver() {
+    return std::make_unique<ResolutionSolver>();
+}
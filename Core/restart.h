@@ -0,0 +1,101 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+enum class RestartStrategy { None, Luby, Geometric, LBD };
+
+// Element x (from 0) of the Luby sequence 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ...
+inline long long lubySequence(long long x) {
+    long long size = 1;
+    int seq = 0;
+    while (size < x + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != x) {
+        size = (size - 1) >> 1;
+        seq--;
+        x = x % size;
+    }
+    return 1LL << seq;
+}
+
+// Decides when the search should start over from the root. Luby and geometric restart once a
+// conflict budget is used up, and the budget grows from one restart to the next. LBD restarts, as
+// in Glucose, once the learned clauses of the last WINDOW conflicts are clearly worse (higher
+// LBD) than the average over the whole run.
+struct RestartPolicy {
+    static const int WINDOW = 50;
+
+    RestartStrategy strategy = RestartStrategy::None;
+    long long unit = 100;  // conflicts of the first Luby or geometric run
+    double factor = 1.5;   // geometric growth of the budget
+    double margin = 0.8;   // LBD: restart when margin * recent average > overall average
+    long long conflicts = 0;  // since the last restart
+    long long limit = 0;
+    long long restarts = 0;
+    std::vector<int> recent;  // ring buffer of the last WINDOW LBDs
+    size_t next = 0;
+    long long recentSum = 0;
+    double lbdSum = 0.0;
+    long long lbdCount = 0;
+
+    explicit RestartPolicy(RestartStrategy strategy = RestartStrategy::None) : strategy(strategy) {
+        limit = budget();
+    }
+
+    long long budget() const {
+        if (strategy == RestartStrategy::Luby) return unit * lubySequence(restarts);
+        if (strategy == RestartStrategy::Geometric) return static_cast<long long>(unit * std::pow(factor, static_cast<double>(restarts)));
+        return 0;
+    }
+
+    void conflict(int lbd) {
+        conflicts++;
+        if (strategy != RestartStrategy::LBD) return;
+        lbdSum += lbd;
+        lbdCount++;
+        if (recent.size() < static_cast<size_t>(WINDOW)) {
+            recent.push_back(lbd);
+        } else {
+            recentSum -= recent[next];
+            recent[next] = lbd;
+            next = (next + 1) % WINDOW;
+        }
+        recentSum += lbd;
+    }
+
+    bool due() const {
+        switch (strategy) {
+            case RestartStrategy::None: return false;
+            case RestartStrategy::Luby:
+            case RestartStrategy::Geometric: return conflicts >= limit;
+            case RestartStrategy::LBD:
+                return recent.size() == static_cast<size_t>(WINDOW) &&
+                       margin * recentSum / WINDOW > lbdSum / lbdCount;
+        }
+        return false;
+    }
+
+    // Back to the state of a fresh run, keeping the configuration
+    void reset() {
+        restarts = 0;
+        conflicts = 0;
+        recent.clear();
+        next = 0;
+        recentSum = 0;
+        lbdSum = 0.0;
+        lbdCount = 0;
+        limit = budget();
+    }
+
+    void restart() {
+        restarts++;
+        conflicts = 0;
+        limit = budget();
+        recent.clear();
+        next = 0;
+        recentSum = 0;
+    }
+};
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <cstring>
+#include "solver.h"
+
+std::unique_ptr<Solver> makeSolver(const SolverConfig& config) {
+    switch (config.algorithm) {
+        case Algorithm::Resolution: return makeResolutionSolver();
+        case Algorithm::DP: return makeDpSolver();
+        case Algorithm::DPLL: return makeDpllSolver(config);
+        case Algorithm::CDCL: return makeCdclSolver(config);
+        case Algorithm::LocalSearch: return makeLocalSearchSolver(config);
+    }
+    return nullptr;
+}
+
+bool parseAlgorithm(const char* name, Algorithm& algorithm) {
+    if (std::strcmp(name, "resolution") == 0) algorithm = Algorithm::Resolution;
+    else if (std::strcmp(name, "dp") == 0) algorithm = Algorithm::DP;
+    else if (std::strcmp(name, "dpll") == 0) algorithm = Algorithm::DPLL;
+    else if (std::strcmp(name, "cdcl") == 0) algorithm = Algorithm::CDCL;
+    else if (std::strcmp(name, "local") == 0) algorithm = Algorithm::LocalSearch;
+    else return false;
+    return true;
+}
+
+bool parseHeuristic(const char* name, Heuristic& heuristic) {
+    if (std::strcmp(name, "first") == 0) heuristic = Heuristic::First;
+    else if (std::strcmp(name, "static") == 0) heuristic = Heuristic::Static;
+    else if (std::strcmp(name, "dynamic") == 0) heuristic = Heuristic::Dynamic;
+    else if (std::strcmp(name, "vsids") == 0) heuristic = Heuristic::VSIDS;
+    else if (std::strcmp(name, "random") == 0) heuristic = Heuristic::Random;
+    else if (std::strcmp(name, "jw") == 0) heuristic = Heuristic::JeroslowWang;
+    else if (std::strcmp(name, "moms") == 0) heuristic = Heuristic::MOMS;
+    else return false;
+    return true;
+}
+
+bool parseRestartStrategy(const char* name, RestartStrategy& strategy) {
+    if (std::strcmp(name, "none") == 0) strategy = RestartStrategy::None;
+    else if (std::strcmp(name, "luby") == 0) strategy = RestartStrategy::Luby;
+    else if (std::strcmp(name, "geometric") == 0) strategy = RestartStrategy::Geometric;
+    else if (std::strcmp(name, "lbd") == 0) strategy = RestartStrategy::LBD;
+    else return false;
+    return true;
+}
+
+bool parseWalkStrategy(const char* name, WalkStrategy& strategy) {
+    if (std::strcmp(name, "walksat") == 0) strategy = WalkStrategy::WalkSAT;
+    else if (std::strcmp(name, "probsat") == 0) strategy = WalkStrategy::ProbSAT;
+    else return false;
+    return true;
+}
+
+const char* algorithmName(Algorithm algorithm) {
+    switch (algorithm) {
+        case Algorithm::Resolution: return "resolution";
+        case Algorithm::DP: return "dp";
+        case Algorithm::DPLL: return "dpll";
+        case Algorithm::CDCL: return "cdcl";
+        case Algorithm::LocalSearch: return "local";
+    }
+    return "";
+}
+
+const char* heuristicName(Heuristic heuristic) {
+    switch (heuristic) {
+        case Heuristic::First: return "first-unassigned";
+        case Heuristic::Static: return "static-frequency";
+        case Heuristic::Dynamic: return "dynamic-frequency";
+        case Heuristic::VSIDS: return "vsids";
+        case Heuristic::Random: return "random";
+        case Heuristic::JeroslowWang: return "jeroslow-wang";
+        case Heuristic::MOMS: return "moms";
+    }
+    return "";
+}
+
+const char* resultName(SolveResult result) {
+    switch (result) {
+        case SolveResult::Satisfiable: return "Satisfiable";
+        case SolveResult::Unsatisfiable: return "Unsatisfiable";
+        case SolveResult::Unknown: return "Unknown";
+    }
+    return "";
+}
+
+void printSolverStats(const SolverStats& stats, const SolverConfig& config) {
+    if (config.algorithm == Algorithm::DPLL || config.algorithm == Algorithm::CDCL) {
+        std::cout << "Decision Steps: " << stats.decisions << std::endl;
+        std::cout << "Propagation Steps: " << stats.propagations << std::endl;
+        std::cout << "Restarts: " << stats.restarts << std::endl;
+        std::cout << "Conflicts: " << stats.conflicts << std::endl;
+    }
+    if (config.algorithm == Algorithm::CDCL) {
+        std::cout << "Learned Clauses: " << stats.learned << std::endl;
+        std::cout << "Deleted Clauses: " << stats.deleted << std::endl;
+    }
+    if (config.algorithm == Algorithm::LocalSearch || config.warmStart) std::cout << "Flips: " << stats.flips << std::endl;
+    if (config.algorithm == Algorithm::DP) std::cout << "Eliminated Variables: " << stats.eliminated << std::endl;
+    if (config.algorithm == Algorithm::DP || config.algorithm == Algorithm::Resolution) {
+        std::cout << "Resolvents: " << stats.resolvents << std::endl;
+    }
+}
+
+bool applyOptions(const SolverOptions& options, SolverConfig& config) {
+    config.seed = options.seed;
+    config.learnedMemory = options.learnedMemory;
+    config.localSearch.noise = options.noise;
+    config.localSearch.maxFlips = options.flips;
+    config.localSearch.timeLimit = options.timeLimit;
+    config.warmStart = options.warmStart;
+    if (options.algorithm && !parseAlgorithm(options.algorithm, config.algorithm)) {
+        std::cerr << "Unknown algorithm " << options.algorithm << " (resolution, dp, dpll, cdcl or local)" << std::endl;
+        return false;
+    }
+    if (options.heuristic && !parseHeuristic(options.heuristic, config.heuristic)) {
+        std::cerr << "Unknown heuristic " << options.heuristic << " (first, static, jw, moms, dynamic, vsids or random)" << std::endl;
+        return false;
+    }
+    if (options.restarts && !parseRestartStrategy(options.restarts, config.restarts)) {
+        std::cerr << "Unknown restart strategy " << options.restarts << " (none, luby, geometric or lbd)" << std::endl;
+        return false;
+    }
+    if (options.walk && !parseWalkStrategy(options.walk, config.localSearch.strategy)) {
+        std::cerr << "Unknown local search " << options.walk << " (walksat or probsat)" << std::endl;
+        return false;
+    }
+    return true;
+}
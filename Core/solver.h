@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "clause_arena.h"
+#include "stats.h"
+#include "watched_formula.h"
+#include "restart.h"
+#include "local_search.h"
+#include "options.h"
+
+enum class Algorithm { Resolution, DP, DPLL, CDCL, LocalSearch };
+
+// Branching heuristics of the DPLL engine; CDCL always branches with VSIDS. Static, JeroslowWang
+// and MOMS follow an order fixed before the search (Core/static_order.h).
+enum class Heuristic { First, Static, Dynamic, VSIDS, Random, JeroslowWang, MOMS };
+
+enum class SolveResult { Satisfiable, Unsatisfiable, Unknown };
+
+struct SolverConfig {
+    Algorithm algorithm = Algorithm::DPLL;
+    Heuristic heuristic = Heuristic::First;
+    unsigned seed = 1;  // random heuristic only
+    // DPLL and CDCL; any strategy other than None also turns on phase saving
+    RestartStrategy restarts = RestartStrategy::None;
+    size_t learnedMemory = 0;  // CDCL: megabytes the learned clauses may take, 0 for no limit
+    LocalSearchConfig localSearch;  // seeded from seed
+    bool warmStart = false;  // DPLL and CDCL: take initial phases from a local search run
+};
+
+// Common interface of every algorithm. A solver is used for one formula at a time; the model is
+// only meaningful after solve returned Satisfiable and hasModel() is true (Resolution and DP decide
+// satisfiability without building one). Local search is incomplete: it returns Unknown when its
+// budget runs out, whether or not the formula is satisfiable.
+class Solver {
+public:
+    virtual ~Solver() = default;
+
+    virtual SolveResult solve(const ClauseArena& formula) = 0;
+    virtual bool hasModel() const { return false; }
+
+    const Assignment& model() const { return assignment; }
+    // Safe to read from other threads while solve runs, e.g. by a StatsMonitor
+    const SolverStats& stats() const { return counters; }
+    // Back to zero, e.g. between the formulas of a batch; counters otherwise add up across solves
+    void resetStats() { counters = SolverStats(); }
+
+    // Once flag is raised the DPLL, CDCL and Resolution searches give up and solve returns Unknown
+    void setStop(const std::atomic<bool>* flag) { stop = flag; }
+
+protected:
+    bool stopRequested() const { return stop && stop->load(std::memory_order_relaxed); }
+
+    Assignment assignment;
+    SolverStats counters;
+    const std::atomic<bool>* stop = nullptr;
+};
+
+// CDCL kept alive across queries: clauses, learned clauses and VSIDS activities persist between
+// calls, and clauses may be added in between. Variables are created as literals mention them.
+// solve(formula) starts over from scratch with just formula.
+class IncrementalSolver : public Solver {
+public:
+    using Solver::solve;
+
+    virtual void addClause(const Clause& clause) = 0;
+
+    // Solves the clauses added so far with every assumption held true for this call only. On
+    // Unsatisfiable, failedAssumptions() is a subset of the assumptions that already conflicts with
+    // the clauses; it is empty when the clauses alone are unsatisfiable.
+    virtual SolveResult solve(const std::vector<Literal>& assumptions) = 0;
+
+    const std::vector<Literal>& failedAssumptions() const { return core; }
+
+protected:
+    std::vector<Literal> core;
+};
+
+std::unique_ptr<Solver> makeSolver(const SolverConfig& config);
+std::unique_ptr<IncrementalSolver> makeIncrementalSolver(const SolverConfig& config = SolverConfig());
+
+// Per-algorithm factories behind makeSolver
+std::unique_ptr<Solver> makeResolutionSolver();
+std::unique_ptr<Solver> makeDpSolver();
+std::unique_ptr<Solver> makeDpllSolver(const SolverConfig& config);
+std::unique_ptr<Solver> makeCdclSolver(const SolverConfig& config);
+std::unique_ptr<Solver> makeLocalSearchSolver(const SolverConfig& config);
+
+// Names used on the command line; parsing returns false for unknown names
+bool parseAlgorithm(const char* name, Algorithm& algorithm);
+bool parseHeuristic(const char* name, Heuristic& heuristic);
+bool parseRestartStrategy(const char* name, RestartStrategy& strategy);
+bool parseWalkStrategy(const char* name, WalkStrategy& strategy);
+const char* algorithmName(Algorithm algorithm);
+const char* heuristicName(Heuristic heuristic);
+// First line of the report: Satisfiable, Unsatisfiable or Unknown
+const char* resultName(SolveResult result);
+// The statistics lines of the report that config's algorithm keeps counts for
+void printSolverStats(const SolverStats& stats, const SolverConfig& config);
+
+// Applies the solver options (everything but the input and preprocessing ones) to config; reports
+// unknown names
+bool applyOptions(const SolverOptions& options, SolverConfig& config);
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "clause_arena.h"
+#include "watched_formula.h"
+
+// Scores a static order can be sorted by
+enum class StaticScore {
+    Frequency,     // occurrences of the variable
+    JeroslowWang,  // sum of 2^-|C| over the clauses C it occurs in, both polarities
+    MOMS           // occurrences in the shortest clauses, both polarities and their balance
+};
+
+// MOMS weighs the shortest clauses as (f(x) + f(-x)) * 2^MOMS_SHIFT + f(x) * f(-x)
+const int MOMS_SHIFT = 10;
+
+// Branching order fixed before the search: the variables of the formula sorted once by score,
+// ties by occurrence count and then by index. Every variable in front of the cursor is assigned,
+// so picking the next one only moves the cursor forward; a backtrack puts it back where it stood
+// when the undone level was opened, which is amortized O(1) per decision.
+struct StaticOrder {
+    std::vector<int> order;
+    std::vector<signed char> polarity;  // 1 if the positive literal is scored at least as high, by variable
+    std::vector<size_t> saved;          // cursor at the opening of each decision level
+    size_t cursor = 0;
+
+    void build(const ClauseArena& formula, StaticScore score) {
+        std::vector<double> positive(formula.numVars + 1, 0.0), negative(formula.numVars + 1, 0.0);
+        std::vector<int> frequency(formula.numVars + 1, 0);
+        size_t shortest = 0;  // MOMS: size of the shortest clause with two literals or more
+        for (ClauseView clause : formula) {
+            for (Literal lit : clause) frequency[std::abs(lit)]++;
+            if (clause.size() >= 2 && (shortest == 0 || clause.size() < shortest)) shortest = clause.size();
+        }
+        for (ClauseView clause : formula) {
+            double weight = 1.0;
+            if (score == StaticScore::JeroslowWang) weight = std::ldexp(1.0, -static_cast<int>(clause.size()));
+            if (score == StaticScore::MOMS && clause.size() != shortest) continue;
+            for (Literal lit : clause) (lit > 0 ? positive : negative)[std::abs(lit)] += weight;
+        }
+        std::vector<double> scores(formula.numVars + 1, 0.0);
+        polarity.assign(formula.numVars + 1, 1);
+        order.clear();
+        for (int var = 1; var <= formula.numVars; ++var) {
+            if (frequency[var] == 0) continue;
+            order.push_back(var);
+            if (score == StaticScore::Frequency) {
+                scores[var] = frequency[var];
+                continue;
+            }
+            scores[var] = positive[var] + negative[var];
+            if (score == StaticScore::MOMS) scores[var] = scores[var] * (1 << MOMS_SHIFT) + positive[var] * negative[var];
+            polarity[var] = positive[var] >= negative[var];
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            if (scores[a] != scores[b]) return scores[a] > scores[b];
+            return frequency[a] > frequency[b];
+        });
+        reset();
+    }
+
+    // Back to the front, e.g. after the order was reshuffled
+    void reset() {
+        cursor = 0;
+        saved.clear();
+    }
+
+    // First unassigned variable in the order, 0 if there is none
+    int next(const Assignment& assignment) {
+        while (cursor < order.size() && isAssigned(assignment, order[cursor])) cursor++;
+        return cursor < order.size() ? order[cursor] : 0;
+    }
+
+    // The decided literal of next(), with the polarity its score prefers
+    Literal nextLiteral(const Assignment& assignment) {
+        int var = next(assignment);
+        return polarity.empty() || polarity[var] ? var : -var;
+    }
+
+    void save(size_t level) {
+        if (saved.size() <= level) saved.resize(level + 1);
+        saved[level] = cursor;
+    }
+
+    void restore(size_t level) { cursor = level < saved.size() ? std::min(cursor, saved[level]) : 0; }
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Counter written by the one thread that owns it and read by any other, for progress lines and
+// dumps while the search runs. Updates are a relaxed load and store instead of a read-modify-write,
+// so they compile to a plain add and cost no more than a long long would.
+struct Counter {
+    std::atomic<long long> value{0};
+
+    Counter() = default;
+    Counter(long long initial) : value(initial) {}
+    Counter(const Counter& other) : value(other.load()) {}
+
+    Counter& operator=(const Counter& other) { return *this = other.load(); }
+    Counter& operator=(long long next) {
+        value.store(next, std::memory_order_relaxed);
+        return *this;
+    }
+
+    long long load() const { return value.load(std::memory_order_relaxed); }
+    operator long long() const { return load(); }
+
+    Counter& operator+=(long long amount) { return *this = load() + amount; }
+    Counter& operator++() { return *this += 1; }
+    void operator++(int) { *this += 1; }
+
+    // Keeps the largest value seen
+    void raise(long long candidate) {
+        if (candidate > load()) *this = candidate;
+    }
+};
+
+struct SolverStats {
+    Counter decisions;
+    Counter propagations;
+    Counter conflicts;
+    Counter learned;
+    Counter restarts;
+    Counter deleted;  // learned clauses dropped by CDCL's clause database reductions
+    Counter resolvents;
+    Counter eliminated;
+    Counter flips;     // local search, standalone or as a warm start
+    Counter visits;    // clauses looked at by propagation, published at every decision and conflict
+    Counter maxDepth;  // deepest decision level reached
+};
+
+// Adds the seconds from construction to destruction to total
+struct ScopedTimer {
+    double& total;
+    std::chrono::steady_clock::time_point start;
+
+    explicit ScopedTimer(double& total) : total(total), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+};
+
+// Raised by SIGUSR1, polled by the running StatsMonitor
+inline std::atomic<bool> statsDumpRequested{false};
+
+inline void requestStatsDump(int) {
+    statsDumpRequested.store(true, std::memory_order_relaxed);
+}
+
+inline void printProgressLine(std::ostream& out, const std::string& name, const SolverStats& stats, double seconds) {
+    long long propagations = stats.propagations;
+    out << "Progress " << name << " " << seconds << "s: Decisions " << stats.decisions
+        << ", Propagations " << propagations << ", Conflicts " << stats.conflicts
+        << ", Restarts " << stats.restarts
+        << ", Visits/Propagation " << (propagations > 0 ? static_cast<double>(stats.visits) / propagations : 0.0)
+        << ", Max Depth " << stats.maxDepth;
+    if (stats.resolvents > 0) out << ", Resolvents " << stats.resolvents;
+    if (stats.flips > 0) out << ", Flips " << stats.flips;
+    out << std::endl;
+}
+
+// Reports on running solvers from a thread of its own: one line per watched solver every interval
+// seconds (0 for never) and whenever the process receives SIGUSR1. Lines go to stderr, so the
+// result on stdout keeps its format. A signal handler cannot notify a condition variable, so the
+// thread wakes every 100 ms to check for SIGUSR1, even with periodic reports turned off.
+class StatsMonitor {
+public:
+    explicit StatsMonitor(double interval) : interval(interval) {}
+    ~StatsMonitor() { stop(); }
+
+    // Solvers must be watched before start() and outlive stop()
+    void watch(std::string name, const SolverStats& stats) { watched.emplace_back(std::move(name), &stats); }
+
+    void start() {
+        begin = std::chrono::steady_clock::now();
+#ifdef SIGUSR1
+        std::signal(SIGUSR1, requestStatsDump);
+#endif
+        running = true;
+        worker = std::thread([this]() { loop(); });
+    }
+
+    void stop() {
+        if (!running) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+        running = false;
+#ifdef SIGUSR1
+        std::signal(SIGUSR1, SIG_DFL);
+#endif
+    }
+
+    void report() const {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        for (const auto& entry : watched) printProgressLine(std::cerr, entry.first, *entry.second, seconds);
+    }
+
+private:
+    void loop() {
+        const auto poll = std::chrono::milliseconds(100);
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(interval));
+        auto nextReport = begin + period;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!wake.wait_for(lock, poll, [this]() { return stopping; })) {
+            bool due = interval > 0.0 && std::chrono::steady_clock::now() >= nextReport;
+            if (statsDumpRequested.exchange(false, std::memory_order_relaxed) || due) report();
+            while (interval > 0.0 && std::chrono::steady_clock::now() >= nextReport) {
+                nextReport += period;
+            }
+        }
+    }
+
+    double interval;
+    std::vector<std::pair<std::string, const SolverStats*>> watched;
+    std::chrono::steady_clock::time_point begin;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    bool running = false;
+};
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include "clause_arena.h"
+#include "preprocess.h"
+
+// Work the automorphism search may spend, counted in vertices visited and copied, before it stops
+// with the generators found so far
+const long long SYMMETRY_BUDGET = 20000000;
+
+// Colored graph of a formula: one vertex per literal, joined to the vertex of its negation, and one
+// per clause, joined to the vertices of its literals. Literals of variables that occur in no clause
+// get a color of their own, so they are never moved. An automorphism maps literals to literals and
+// negations to negations, so it permutes the literals of the formula and maps clauses to clauses.
+struct SymmetryGraph {
+    std::vector<int> color;
+    std::vector<std::vector<int>> adjacent;
+    int numVars = 0;
+
+    explicit SymmetryGraph(const ClauseArena& formula) : numVars(formula.numVars) {
+        size_t literals = 2 * static_cast<size_t>(numVars);
+        color.assign(literals, 0);
+        adjacent.resize(literals);
+        std::vector<bool> occurs(numVars + 1, false);
+        for (int var = 1; var <= numVars; ++var) link(vertex(var), vertex(-var));
+        for (ClauseView clause : formula) {
+            int node = static_cast<int>(color.size());
+            color.push_back(1);
+            adjacent.emplace_back();
+            for (Literal lit : clause) {
+                occurs[std::abs(lit)] = true;
+                if (std::find(adjacent[node].begin(), adjacent[node].end(), vertex(lit)) == adjacent[node].end()) {
+                    link(node, vertex(lit));
+                }
+            }
+        }
+        for (int var = 1; var <= numVars; ++var) {
+            if (!occurs[var]) color[vertex(var)] = color[vertex(-var)] = 1 + var;
+        }
+    }
+
+    static int vertex(Literal lit) { return lit > 0 ? 2 * (lit - 1) : 2 * (-lit - 1) + 1; }
+    static Literal literal(int vertex) { return vertex % 2 == 0 ? vertex / 2 + 1 : -(vertex / 2 + 1); }
+
+    int size() const { return static_cast<int>(color.size()); }
+
+    // True if perm, a permutation of the vertices, keeps every color and every edge
+    bool automorphism(const std::vector<int>& perm, std::vector<int>& mark) const {
+        mark.assign(size(), -1);
+        for (int v = 0; v < size(); ++v) {
+            if (color[v] != color[perm[v]] || adjacent[v].size() != adjacent[perm[v]].size()) return false;
+        }
+        for (int v = 0; v < size(); ++v) {
+            for (int u : adjacent[perm[v]]) mark[u] = v;
+            for (int u : adjacent[v]) {
+                if (mark[perm[u]] != v) return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    void link(int a, int b) {
+        adjacent[a].push_back(b);
+        adjacent[b].push_back(a);
+    }
+};
+
+// Ordered partition of the vertices: elements lists them cell by cell, and each cell is named by
+// the index of its first element
+struct OrderedPartition {
+    std::vector<int> elements;
+    std::vector<int> position;  // index of each vertex in elements
+    std::vector<int> cellOf;    // first index of the cell of each vertex
+    std::vector<int> cellEnd;   // by first index of a cell, one past its last
+    int cells = 0;
+
+    bool discrete() const { return cells == static_cast<int>(elements.size()); }
+
+    // Same cells at the same places as other
+    bool sameShape(const OrderedPartition& other) const {
+        if (cells != other.cells) return false;
+        for (int start = 0; start < static_cast<int>(elements.size()); start = cellEnd[start]) {
+            if (cellEnd[start] != other.cellEnd[start]) return false;
+        }
+        return true;
+    }
+
+    // First cell with more than one vertex, -1 if there is none
+    int firstOpenCell() const {
+        for (int start = 0; start < static_cast<int>(elements.size()); start = cellEnd[start]) {
+            if (cellEnd[start] - start > 1) return start;
+        }
+        return -1;
+    }
+};
+
+// Generators of the automorphism group of a colored graph, found by partition refinement in the
+// manner of nauty and saucy. The first path individualizes the first vertex of the first open cell
+// at every level, refining to an equitable partition each time, until the partition is discrete.
+// Then, from the deepest level up, every other vertex of the cell individualized at that level is
+// tried in its place and the search follows the same cells down; a discrete partition reached
+// that way maps the first leaf onto itself by an automorphism if the graph agrees. Candidates in
+// the orbit of the first choice under the generators found so far are skipped. Refinement is the
+// same isomorphism-invariant procedure on both sides, so a mismatch in the cell shapes rules a
+// branch out; every generator is checked against the graph before it is kept, so the result is
+// sound even when the budget cuts the search short.
+class AutomorphismSearch {
+public:
+    explicit AutomorphismSearch(const SymmetryGraph& graph, long long budget = SYMMETRY_BUDGET)
+        : graph(graph), budget(budget), count(graph.size(), 0), cellMark(graph.size(), false) {}
+
+    std::vector<std::vector<int>> run() {
+        int size = graph.size();
+        OrderedPartition p;
+        p.elements.resize(size);
+        p.position.resize(size);
+        p.cellOf.resize(size);
+        p.cellEnd.assign(size, 0);
+        for (int v = 0; v < size; ++v) p.elements[v] = v;
+        std::stable_sort(p.elements.begin(), p.elements.end(), [&](int a, int b) { return graph.color[a] < graph.color[b]; });
+        std::vector<int> splitters;
+        for (int i = 0; i < size; ++i) {
+            if (i == 0 || graph.color[p.elements[i]] != graph.color[p.elements[i - 1]]) {
+                splitters.push_back(i);
+                p.cells++;
+            }
+            p.cellOf[p.elements[i]] = splitters.back();
+            p.position[p.elements[i]] = i;
+        }
+        for (size_t k = 0; k < splitters.size(); ++k) p.cellEnd[splitters[k]] = k + 1 < splitters.size() ? splitters[k + 1] : size;
+        refine(p, splitters);
+
+        while (!p.discrete() && work < budget) {
+            path.push_back(p);
+            work += 4 * size;
+            int cell = p.firstOpenCell();
+            target.push_back(cell);
+            chosen.push_back(p.elements[cell]);
+            individualize(p, p.elements[cell]);
+        }
+        if (!p.discrete()) return generators;
+        leaf = p;
+
+        orbit.resize(size);
+        for (int v = 0; v < size; ++v) orbit[v] = v;
+        for (size_t level = path.size(); level-- > 0 && work < budget;) {
+            const OrderedPartition& base = path[level];
+            std::vector<int> failed;
+            for (int i = target[level]; i < base.cellEnd[target[level]] && work < budget; ++i) {
+                int w = base.elements[i];
+                int root = find(w);
+                if (root == find(chosen[level]) || std::find(failed.begin(), failed.end(), root) != failed.end()) continue;
+                OrderedPartition q = base;
+                work += 4 * size;
+                individualize(q, w);
+                if (!extend(q, level + 1)) failed.push_back(root);
+            }
+        }
+        return generators;
+    }
+
+private:
+    // Follows the cells of the first path from level on; true once an automorphism was found
+    bool extend(OrderedPartition& q, size_t level) {
+        const OrderedPartition& reference = level < path.size() ? path[level] : leaf;
+        if (!q.sameShape(reference)) return false;
+        if (q.discrete()) return tryLeaf(q);
+        int cell = target[level];
+        // Symmetries tend to fix most vertices, so the first path's own choice goes first
+        std::vector<int> candidates(q.elements.begin() + cell, q.elements.begin() + q.cellEnd[cell]);
+        auto own = std::find(candidates.begin(), candidates.end(), chosen[level]);
+        if (own != candidates.end()) std::iter_swap(candidates.begin(), own);
+        for (int u : candidates) {
+            if (work >= budget) return false;
+            OrderedPartition r = q;
+            work += 4 * graph.size();
+            individualize(r, u);
+            if (extend(r, level + 1)) return true;
+        }
+        return false;
+    }
+
+    bool tryLeaf(const OrderedPartition& q) {
+        std::vector<int> perm(graph.size());
+        for (int i = 0; i < graph.size(); ++i) perm[leaf.elements[i]] = q.elements[i];
+        work += 2 * graph.size();
+        if (!graph.automorphism(perm, mark)) return false;
+        for (int v = 0; v < graph.size(); ++v) orbit[find(v)] = find(perm[v]);
+        generators.push_back(std::move(perm));
+        return true;
+    }
+
+    int find(int v) {
+        while (orbit[v] != v) v = orbit[v] = orbit[orbit[v]];
+        return v;
+    }
+
+    // Splits v off its cell and refines
+    void individualize(OrderedPartition& p, int v) {
+        int start = p.cellOf[v];
+        int end = p.cellEnd[start];
+        if (end - start == 1) return;
+        int other = p.elements[start];
+        std::swap(p.elements[start], p.elements[p.position[v]]);
+        p.position[other] = p.position[v];
+        p.position[v] = start;
+        p.cellEnd[start] = start + 1;
+        p.cellEnd[start + 1] = end;
+        for (int i = start + 1; i < end; ++i) p.cellOf[p.elements[i]] = start + 1;
+        p.cells++;
+        refine(p, {start});
+    }
+
+    // Splits cells until every vertex of a cell has as many neighbours in each cell as the other
+    // vertices of its cell. Cells are split by the neighbour counts of one splitter cell at a time,
+    // lowest count first, and every piece of a split cell becomes a splitter itself.
+    void refine(OrderedPartition& p, std::vector<int> splitters) {
+        std::vector<int> touched, cells;
+        for (size_t head = 0; head < splitters.size(); ++head) {
+            int splitter = splitters[head];
+            touched.clear();
+            cells.clear();
+            for (int i = splitter; i < p.cellEnd[splitter]; ++i) {
+                for (int u : graph.adjacent[p.elements[i]]) {
+                    if (count[u]++ == 0) touched.push_back(u);
+                }
+                work += static_cast<long long>(graph.adjacent[p.elements[i]].size());
+            }
+            for (int u : touched) {
+                int cell = p.cellOf[u];
+                if (!cellMark[cell]) {
+                    cellMark[cell] = true;
+                    cells.push_back(cell);
+                }
+            }
+            std::sort(cells.begin(), cells.end());
+            for (int cell : cells) {
+                cellMark[cell] = false;
+                int end = p.cellEnd[cell];
+                if (end - cell == 1) continue;
+                auto first = p.elements.begin() + cell, last = p.elements.begin() + end;
+                std::sort(first, last, [&](int a, int b) { return count[a] < count[b]; });
+                work += end - cell;
+                int piece = cell;
+                for (int i = cell; i < end; ++i) {
+                    int v = p.elements[i];
+                    p.position[v] = i;
+                    if (i > cell && count[v] != count[p.elements[i - 1]]) {
+                        p.cellEnd[piece] = i;
+                        piece = i;
+                        p.cells++;
+                    }
+                    p.cellOf[v] = piece;
+                }
+                p.cellEnd[piece] = end;
+                if (piece == cell) continue;
+                for (int start = cell; start < end; start = p.cellEnd[start]) splitters.push_back(start);
+            }
+            for (int u : touched) count[u] = 0;
+        }
+    }
+
+    const SymmetryGraph& graph;
+    long long budget;
+    long long work = 0;
+    std::vector<int> count;
+    std::vector<bool> cellMark;
+    std::vector<int> mark;
+    std::vector<OrderedPartition> path;  // partition at each level of the first path, before individualizing
+    std::vector<int> target;             // cell individualized at each level
+    std::vector<int> chosen;             // vertex the first path individualized at each level
+    OrderedPartition leaf;
+    std::vector<int> orbit;              // union-find over the orbits of the generators found so far
+    std::vector<std::vector<int>> generators;
+};
+
+// Lex-leader predicate of the literal permutation image (image[var] is the literal var maps to):
+// with the variables in increasing order, x <= image(x) lexicographically, false before true.
+// Only variables the permutation moves take part, and equal[j] is an auxiliary variable that is
+// true while the assignment agrees with its image on the first j of them. A variable mapped onto
+// its own negation can never agree, so the predicate stops there.
+inline size_t addLexLeader(const std::vector<Literal>& image, int& numVars, ClauseArena& clauses) {
+    size_t added = 0;
+    Literal equal = 0;  // 0 stands for true before the first moved variable
+    auto emit = [&](std::initializer_list<Literal> lits) {
+        std::vector<Literal> clause;
+        for (Literal lit : lits) {
+            if (lit != 0 && std::find(clause.begin(), clause.end(), lit) == clause.end()) clause.push_back(lit);
+        }
+        clauses.add(clause);
+        added++;
+    };
+    std::vector<int> moved;
+    for (int var = 1; var < static_cast<int>(image.size()); ++var) {
+        if (image[var] != var) moved.push_back(var);
+    }
+    for (size_t k = 0; k < moved.size(); ++k) {
+        int var = moved[k];
+        Literal y = image[var];
+        Literal notEqual = equal == 0 ? 0 : -equal;
+        // Agreeing so far, x may not exceed its image
+        emit({notEqual, -var, y});
+        if (y == -var || k + 1 == moved.size()) break;
+        Literal next = ++numVars;
+        // Still agreeing after var if it does not fall below its image either
+        emit({notEqual, -var, next});
+        emit({notEqual, y, next});
+        equal = next;
+    }
+    return added;
+}
+
+// Adds lex-leader symmetry-breaking clauses for the generators of the formula's automorphism group.
+// The lexicographically smallest model in each class of symmetric models satisfies them all, so the
+// result is equisatisfiable with formula, and its models restricted to the variables of formula are
+// models of formula. Auxiliary variables are numbered after them.
+inline ClauseArena breakSymmetries(const ClauseArena& formula, PreprocessStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    ClauseArena result = formula;
+    SymmetryGraph graph(formula);
+    AutomorphismSearch search(graph);
+    int numVars = formula.numVars;
+    for (const std::vector<int>& perm : search.run()) {
+        std::vector<Literal> image(formula.numVars + 1, 0);
+        bool identity = true;
+        for (int var = 1; var <= formula.numVars; ++var) {
+            image[var] = SymmetryGraph::literal(perm[SymmetryGraph::vertex(var)]);
+            if (image[var] != var) identity = false;
+        }
+        // Permutations of duplicate clauses alone leave every literal in place
+        if (identity) continue;
+        stats.symmetryGenerators++;
+        stats.symmetryClauses += addLexLeader(image, numVars, result);
+    }
+    result.declareVars(numVars);
+    stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
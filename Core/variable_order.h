@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+
+// Indexed binary max-heap of variables keyed by VSIDS activity
+struct VariableOrder {
+    std::vector<double> activity;
+    std::vector<int> heap;
+    std::vector<int> position;  // index of each variable in heap, -1 when not queued
+    double increment = 1.0;
+    double decay = 0.95;
+
+    explicit VariableOrder(int numVars = 0) : activity(numVars + 1, 0.0), position(numVars + 1, -1) {}
+
+    // Every variable up to numVars back to no activity and not queued, keeping the storage
+    void reset(int numVars) {
+        activity.assign(numVars + 1, 0.0);
+        position.assign(numVars + 1, -1);
+        heap.clear();
+        increment = 1.0;
+    }
+
+    // Makes room for variables up to numVars, which start with no activity and are not queued
+    void grow(int numVars) {
+        if (numVars + 1 <= static_cast<int>(activity.size())) return;
+        activity.resize(numVars + 1, 0.0);
+        position.resize(numVars + 1, -1);
+    }
+
+    bool contains(int var) const { return position[var] >= 0; }
+    bool empty() const { return heap.empty(); }
+
+    void insert(int var) {
+        if (contains(var)) return;
+        position[var] = static_cast<int>(heap.size());
+        heap.push_back(var);
+        siftUp(position[var]);
+    }
+
+    int removeMax() {
+        int top = heap[0];
+        heap[0] = heap.back();
+        position[heap[0]] = 0;
+        heap.pop_back();
+        position[top] = -1;
+        if (!heap.empty()) siftDown(0);
+        return top;
+    }
+
+    // EVSIDS: bumping by a growing increment is equivalent to decaying every other activity
+    void bump(int var) {
+        activity[var] += increment;
+        if (activity[var] > 1e100) {
+            for (double& a : activity) a *= 1e-100;
+            increment *= 1e-100;
+        }
+        if (contains(var)) siftUp(position[var]);
+    }
+
+    void decayActivities() {
+        increment /= decay;
+    }
+
+    void siftUp(int i) {
+        int var = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (activity[heap[parent]] >= activity[var]) break;
+            heap[i] = heap[parent];
+            position[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = var;
+        position[var] = i;
+    }
+
+    void siftDown(int i) {
+        int var = heap[i];
+        int size = static_cast<int>(heap.size());
+        while (2 * i + 1 < size) {
+            int child = 2 * i + 1;
+            if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) child++;
+            if (activity[heap[child]] <= activity[var]) break;
+            heap[i] = heap[child];
+            position[heap[i]] = i;
+            i = child;
+        }
+        heap[i] = var;
+        position[var] = i;
+    }
+};
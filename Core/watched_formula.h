@@ -0,0 +1,274 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "clause_arena.h"
+#include "stats.h"
+
+using Clause = std::vector<Literal>;
+
+// Value of every variable in one byte, indexed by variable, so evaluating a literal is a single
+// load. The solvers size it to their formula up front and evaluate literals unchecked; value()
+// and assign() also accept variables beyond the current size, for models extended afterwards.
+struct Assignment {
+    static constexpr signed char UNASSIGNED = -1;
+    std::vector<signed char> values;  // 1 true, 0 false or UNASSIGNED
+
+    explicit Assignment(int numVars = 0) : values(numVars + 1, UNASSIGNED) {}
+
+    int numVars() const { return static_cast<int>(values.size()) - 1; }
+
+    // Every variable up to numVars unassigned
+    void reset(int numVars) { values.assign(numVars + 1, UNASSIGNED); }
+    void clear() { reset(0); }
+
+    // Drops the variables beyond numVars, e.g. auxiliary ones the input does not have
+    void truncate(int numVars) {
+        if (numVars < this->numVars()) values.resize(numVars + 1);
+    }
+
+    void grow(int numVars) {
+        if (numVars >= static_cast<int>(values.size())) values.resize(numVars + 1, UNASSIGNED);
+    }
+
+    bool isTrue(Literal lit) const { return values[std::abs(lit)] == (lit > 0); }
+    bool isFalse(Literal lit) const { return values[std::abs(lit)] == (lit < 0); }
+
+    signed char value(int var) const { return var < static_cast<int>(values.size()) ? values[var] : UNASSIGNED; }
+    bool assigned(int var) const { return value(var) != UNASSIGNED; }
+
+    void assign(Literal lit) {
+        grow(std::abs(lit));
+        values[std::abs(lit)] = lit > 0;
+    }
+
+    void unassign(int var) { values[var] = UNASSIGNED; }
+};
+
+// Clause of N literals as seen from one of them, with the other N - 1 stored inline: once that
+// literal is false, the clause is evaluated without loading it from the arena
+template <int N>
+struct InlineClause {
+    Literal others[N - 1];
+    ClauseRef clause;
+};
+
+// Clause database with two watched literals per clause (positions 0 and 1); learned clauses are
+// appended. Clauses of two and three literals are not watched: each of their literals lists the
+// others inline instead, so propagating them never touches the clause itself and never moves a
+// watch. Random 3-SAT and the coloring and pigeonhole encodings are almost all such clauses.
+struct WatchedFormula {
+    ClauseArena clauses;
+    std::vector<std::vector<int>> watches;  // indexed by watchIndex(lit), holds clause indices
+    std::vector<std::vector<InlineClause<2>>> binaries;   // indexed by watchIndex(lit), the binary clauses of lit
+    std::vector<std::vector<InlineClause<3>>> ternaries;  // indexed by watchIndex(lit), the ternary clauses of lit
+    std::vector<Literal> units;
+    bool hasEmptyClause = false;
+    int numVars = 0;
+    long long visits = 0;  // watch list entries propagate looked at
+
+    // Empty again with room for vars variables. The arena and the lists keep their capacity, and
+    // lists beyond the new variables stay around empty, so a solver reused for formula after
+    // formula stops allocating once it has seen the largest.
+    void reset(int vars) {
+        clauses.clear();
+        for (std::vector<int>& list : watches) list.clear();
+        for (std::vector<InlineClause<2>>& list : binaries) list.clear();
+        for (std::vector<InlineClause<3>>& list : ternaries) list.clear();
+        growLists(vars);
+        clauses.declareVars(vars);
+        units.clear();
+        hasEmptyClause = false;
+        numVars = vars;
+        visits = 0;
+    }
+
+    // Watch and implication lists for every literal up to vars
+    void growLists(int vars) {
+        if (watches.size() >= 2 * static_cast<size_t>(vars) + 2) return;
+        watches.resize(2 * vars + 2);
+        binaries.resize(2 * vars + 2);
+        ternaries.resize(2 * vars + 2);
+    }
+};
+
+// Assignment trail: literals in assignment order plus the trail size at each decision level
+struct Trail {
+    std::vector<Literal> literals;
+    std::vector<size_t> levelStart;
+    size_t propagated = 0;  // literals before this index have already been propagated
+
+    void clear() {
+        literals.clear();
+        levelStart.clear();
+        propagated = 0;
+    }
+};
+
+inline int watchIndex(Literal lit) {
+    return lit > 0 ? 2 * lit : 2 * (-lit) + 1;
+}
+
+inline bool isTrue(const Assignment& assignment, Literal lit) {
+    return assignment.isTrue(lit);
+}
+
+inline bool isFalse(const Assignment& assignment, Literal lit) {
+    return assignment.isFalse(lit);
+}
+
+inline bool isAssigned(const Assignment& assignment, int var) {
+    return assignment.values[var] != Assignment::UNASSIGNED;
+}
+
+// Stores a clause of two or more distinct literals and lists it inline under each of its literals
+// if it has two or three, or watches its first two otherwise
+inline ClauseRef attachClause(WatchedFormula& wf, const Clause& clause, uint32_t flags = 0) {
+    ClauseRef index = wf.clauses.add(clause, flags);
+    if (clause.size() == 2) {
+        wf.binaries[watchIndex(clause[0])].push_back({{clause[1]}, index});
+        wf.binaries[watchIndex(clause[1])].push_back({{clause[0]}, index});
+    } else if (clause.size() == 3) {
+        wf.ternaries[watchIndex(clause[0])].push_back({{clause[1], clause[2]}, index});
+        wf.ternaries[watchIndex(clause[1])].push_back({{clause[0], clause[2]}, index});
+        wf.ternaries[watchIndex(clause[2])].push_back({{clause[0], clause[1]}, index});
+    } else {
+        wf.watches[watchIndex(clause[0])].push_back(index);
+        wf.watches[watchIndex(clause[1])].push_back(index);
+    }
+    return index;
+}
+
+// Loads formula into wf, replacing what it held
+inline void buildWatches(const ClauseArena& formula, WatchedFormula& wf) {
+    wf.reset(formula.numVars);
+    wf.clauses.reserve(formula.numClauses(), formula.literals.size());
+    Clause clause;
+    for (ClauseView input : formula) {
+        // Drop duplicate literals so the two watches always point at distinct literals
+        clause.clear();
+        for (Literal lit : input) {
+            if (std::find(clause.begin(), clause.end(), lit) == clause.end()) clause.push_back(lit);
+        }
+        if (clause.empty()) {
+            wf.hasEmptyClause = true;
+        } else if (clause.size() == 1) {
+            wf.units.push_back(clause[0]);
+        } else {
+            attachClause(wf, clause);
+        }
+    }
+}
+
+inline WatchedFormula buildWatches(const ClauseArena& formula) {
+    WatchedFormula wf;
+    buildWatches(formula, wf);
+    return wf;
+}
+
+// Make lit true and push it on the trail for propagation; fails if lit is already false
+inline bool enqueue(Assignment& assignment, Trail& trail, Literal lit) {
+    if (isFalse(assignment, lit)) return false;
+    if (isTrue(assignment, lit)) return true;
+    assignment.assign(lit);
+    trail.literals.push_back(lit);
+    return true;
+}
+
+inline void newDecisionLevel(Trail& trail) {
+    trail.levelStart.push_back(trail.literals.size());
+}
+
+// Undo every assignment made at or above the given decision level
+inline void backtrack(Trail& trail, Assignment& assignment, size_t level) {
+    size_t start = trail.levelStart[level];
+    for (size_t i = start; i < trail.literals.size(); ++i) assignment.unassign(std::abs(trail.literals[i]));
+    trail.literals.resize(start);
+    trail.levelStart.resize(level);
+    trail.propagated = start;
+}
+
+// Evaluates the inline clauses of a literal that just became false: each one that is down to a
+// single open literal implies it, and one with none left is a conflict. N is a compile-time
+// constant, so the loop over the other literals unrolls. Returns the conflicting clause or -1.
+template <int N, typename Assign>
+int propagateInline(const std::vector<InlineClause<N>>& list, const Assignment& assignment, Assign& assign) {
+    for (const InlineClause<N>& entry : list) {
+        Literal open = 0;
+        int numOpen = 0;
+        bool satisfied = false;
+        for (int k = 0; k < N - 1 && !satisfied; ++k) {
+            Literal lit = entry.others[k];
+            if (isTrue(assignment, lit)) {
+                satisfied = true;
+            } else if (!isFalse(assignment, lit)) {
+                open = lit;
+                numOpen++;
+            }
+        }
+        if (satisfied || numOpen > 1) continue;
+        if (numOpen == 0) return entry.clause;
+        assign(open, entry.clause);
+    }
+    return -1;
+}
+
+// Only visits clauses of a literal that just became false: its binary clauses, then its ternary
+// clauses, then the longer clauses watching it. Every implied literal is handed to
+// assign(lit, clauseIndex), which must put it on the trail; longer clauses are reordered so it
+// sits at position 0, binary and ternary clauses are left as they are.
+// Returns the index of a conflicting clause, or -1 if propagation reached a fixpoint
+template <typename Assign>
+int propagate(WatchedFormula& wf, const Assignment& assignment, Trail& trail, Assign assign) {
+    while (trail.propagated < trail.literals.size()) {
+        Literal falseLit = -trail.literals[trail.propagated++];
+        const std::vector<InlineClause<2>>& binaries = wf.binaries[watchIndex(falseLit)];
+        const std::vector<InlineClause<3>>& ternaries = wf.ternaries[watchIndex(falseLit)];
+        wf.visits += static_cast<long long>(binaries.size() + ternaries.size());
+        int conflict = propagateInline(binaries, assignment, assign);
+        if (conflict < 0) conflict = propagateInline(ternaries, assignment, assign);
+        if (conflict >= 0) return conflict;
+        std::vector<int>& watchers = wf.watches[watchIndex(falseLit)];
+        size_t i = 0, j = 0;
+        while (i < watchers.size()) {
+            int index = watchers[i++];
+            ClauseView clause = wf.clauses[index];
+            if (clause[0] == falseLit) std::swap(clause[0], clause[1]);
+            if (isTrue(assignment, clause[0])) {
+                watchers[j++] = index;
+                continue;
+            }
+            bool moved = false;
+            for (size_t k = 2; k < clause.size(); ++k) {
+                if (!isFalse(assignment, clause[k])) {
+                    std::swap(clause[1], clause[k]);
+                    wf.watches[watchIndex(clause[1])].push_back(index);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+            watchers[j++] = index;
+            if (isFalse(assignment, clause[0])) {
+                // Conflict: keep the remaining watchers before bailing out
+                wf.visits += static_cast<long long>(i);
+                while (i < watchers.size()) watchers[j++] = watchers[i++];
+                watchers.resize(j);
+                return index;
+            }
+            assign(clause[0], index);
+        }
+        wf.visits += static_cast<long long>(i);
+        watchers.resize(j);
+    }
+    return -1;
+}
+
+// Plain DPLL propagation; false on conflict
+inline bool unitPropagation(WatchedFormula& wf, Assignment& assignment, Trail& trail, Counter& propagations) {
+    return propagate(wf, assignment, trail, [&](Literal lit, int) {
+        enqueue(assignment, trail, lit);
+        propagations++;
+    }) < 0;
+}
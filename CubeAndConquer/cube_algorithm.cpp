@@ -0,0 +1,342 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include "../Core/frontend.h"
+#include "../Core/watched_formula.h"
+#include "../Core/stats.h"
+
+using Formula = ClauseArena;
+using Cube = std::vector<Literal>;  // partial assignment, assumed literal by literal
+
+// Cubes of one thread. The owner pushes and pops at the back; thieves take from the front, where
+// the oldest and usually shortest cubes, and so the largest subtrees, are.
+struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Cube> cubes;
+
+    void push(Cube cube) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cubes.push_back(std::move(cube));
+    }
+
+    bool pop(Cube& cube) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cubes.empty()) return false;
+        cube = std::move(cubes.back());
+        cubes.pop_back();
+        return true;
+    }
+
+    bool steal(Cube& cube) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cubes.empty()) return false;
+        cube = std::move(cubes.front());
+        cubes.pop_front();
+        return true;
+    }
+
+    bool empty() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return cubes.empty();
+    }
+};
+
+struct SharedState {
+    std::vector<int> order;  // variables by decreasing occurrence count, the branching order
+    std::vector<TaskQueue> queues;
+    std::atomic<bool> stop{false};
+    std::atomic<long long> pending{0};  // cubes queued or being solved; none left means unsatisfiable
+    std::atomic<int> idle{0};
+    std::atomic<long long> steals{0};
+    std::atomic<long long> donations{0};
+    std::mutex resultMutex;
+    bool satisfiable = false;
+    Assignment model;
+    // Idle workers sleep on workReady until a cube is donated, the last cube is finished or the
+    // search stops; workEvents counts those signals so none is lost between a scan and the wait
+    std::mutex workMutex;
+    std::condition_variable workReady;
+    long long workEvents = 0;
+
+    explicit SharedState(unsigned threads) : queues(threads) {}
+
+    void signalWork(bool all) {
+        {
+            std::lock_guard<std::mutex> lock(workMutex);
+            workEvents++;
+        }
+        if (all) workReady.notify_all();
+        else workReady.notify_one();
+    }
+};
+
+// Subtrees with fewer open variables than this are not worth handing to another thread
+static const size_t MIN_DONATED_VARS = 12;
+
+// One conquering thread: its own watch lists, assignment and trail over the shared input formula.
+// path holds the literals assumed or decided at each decision level, so any open subtree can be
+// described as a cube and given away.
+struct Worker {
+    unsigned id;
+    SharedState& shared;
+    WatchedFormula wf;
+    Assignment assignment;
+    Trail trail;
+    Cube path;
+    size_t cursor = 0;                // every variable of shared.order in front of it is assigned
+    std::vector<size_t> savedCursor;  // cursor at the opening of each decision level
+    size_t numVars;
+    SolverStats stats;
+    bool rootConflict = false;
+
+    Worker(const Formula& formula, unsigned id, SharedState& shared)
+        : id(id), shared(shared), wf(buildWatches(formula)), assignment(formula.numVars), numVars(shared.order.size()) {
+        rootConflict = wf.hasEmptyClause;
+        for (Literal unit : wf.units) {
+            if (!rootConflict && !enqueue(assignment, trail, unit)) rootConflict = true;
+        }
+        if (!rootConflict && !unitPropagation(wf, assignment, trail, stats.propagations)) rootConflict = true;
+    }
+
+    // First open variable in shared.order. The cursor only moves forward while the search goes
+    // deeper and is put back on backtracking, so this is amortized O(1) per decision.
+    Literal getNextVariable() {
+        while (cursor < shared.order.size() && isAssigned(assignment, shared.order[cursor])) cursor++;
+        return cursor < shared.order.size() ? shared.order[cursor] : 0;
+    }
+
+    // Number of assignments lit implies, or numVars + 1 if it fails outright
+    size_t probe(Literal lit) {
+        size_t level = trail.levelStart.size();
+        size_t before = trail.literals.size();
+        newDecisionLevel(trail);
+        bool ok = enqueue(assignment, trail, lit) && unitPropagation(wf, assignment, trail, stats.propagations);
+        size_t implied = trail.literals.size() - before;
+        backtrack(trail, assignment, level);
+        return ok ? implied : numVars + 1;
+    }
+
+    // Lookahead over the most frequent open variables: the best split assigns the most on both sides
+    Literal lookaheadVariable() {
+        Literal best = 0;
+        size_t bestScore = 0;
+        int candidates = 0;
+        for (int var : shared.order) {
+            if (isAssigned(assignment, var)) continue;
+            size_t score = (probe(var) + 1) * (probe(-var) + 1);
+            if (best == 0 || score > bestScore) {
+                best = var;
+                bestScore = score;
+            }
+            if (++candidates == 16) break;
+        }
+        return best;
+    }
+
+    // Opens one level per literal of cube; false if the cube conflicts
+    bool assume(const Cube& cube) {
+        if (!trail.levelStart.empty()) backtrack(trail, assignment, 0);
+        path.clear();
+        cursor = 0;
+        for (Literal lit : cube) {
+            newDecisionLevel(trail);
+            path.push_back(lit);
+            if (!enqueue(assignment, trail, lit) || !unitPropagation(wf, assignment, trail, stats.propagations)) return false;
+        }
+        return true;
+    }
+
+    bool branch(Literal lit, size_t level) {
+        if (savedCursor.size() <= level) savedCursor.resize(level + 1);
+        savedCursor[level] = cursor;
+        newDecisionLevel(trail);
+        path.push_back(lit);
+        enqueue(assignment, trail, lit);
+        if (dpll()) return true;
+        path.pop_back();
+        backtrack(trail, assignment, level);
+        cursor = savedCursor[level];
+        return false;
+    }
+
+    bool dpll() {
+        if (shared.stop.load(std::memory_order_relaxed)) return false;
+        if (!unitPropagation(wf, assignment, trail, stats.propagations)) {
+            stats.conflicts++;
+            stats.visits = wf.visits;
+            return false;
+        }
+        Literal var = getNextVariable();
+        if (var == 0) {
+            return true;
+        }
+        size_t level = trail.levelStart.size();
+        // While some thread is idle, give the false branch away instead of exploring it here
+        bool donate = shared.idle.load(std::memory_order_relaxed) > 0 &&
+                      numVars - trail.literals.size() >= MIN_DONATED_VARS && shared.queues[id].empty();
+        if (donate) {
+            Cube cube = path;
+            cube.push_back(-var);
+            shared.pending++;
+            shared.donations++;
+            shared.queues[id].push(std::move(cube));
+            shared.signalWork(false);
+        }
+        stats.maxDepth.raise(static_cast<long long>(level) + 1);
+        stats.visits = wf.visits;
+        stats.decisions++;
+        if (branch(var, level)) return true;
+        if (donate) return false;
+        stats.decisions++;
+        return branch(-var, level);
+    }
+
+    bool nextCube(Cube& cube) {
+        if (shared.queues[id].pop(cube)) return true;
+        shared.idle++;
+        bool found = false;
+        while (!found && !shared.stop.load() && shared.pending.load() > 0) {
+            long long events;
+            {
+                std::lock_guard<std::mutex> lock(shared.workMutex);
+                events = shared.workEvents;
+            }
+            for (unsigned k = 1; k < shared.queues.size() && !found; ++k) {
+                found = shared.queues[(id + k) % shared.queues.size()].steal(cube);
+            }
+            if (found) {
+                shared.steals++;
+            } else {
+                std::unique_lock<std::mutex> lock(shared.workMutex);
+                shared.workReady.wait(lock, [&]() {
+                    return shared.workEvents != events || shared.stop.load() || shared.pending.load() == 0;
+                });
+            }
+        }
+        shared.idle--;
+        return found;
+    }
+
+    void run() {
+        Cube cube;
+        while (!shared.stop.load() && nextCube(cube)) {
+            if (assume(cube) && dpll()) {
+                std::lock_guard<std::mutex> lock(shared.resultMutex);
+                if (!shared.satisfiable) {
+                    shared.satisfiable = true;
+                    shared.model = assignment;
+                }
+                shared.stop.store(true);
+                shared.signalWork(true);
+            }
+            if (--shared.pending == 0) shared.signalWork(true);
+        }
+    }
+};
+
+// Splits the search below the worker's current assignment into cubes of the given depth, using the
+// lookahead variable at every node. Cubes refuted by propagation are dropped.
+void split(Worker& worker, int depth, std::vector<Cube>& cubes) {
+    Literal var = depth > 0 ? worker.lookaheadVariable() : 0;
+    if (var == 0) {
+        cubes.push_back(worker.path);
+        return;
+    }
+    for (Literal lit : {var, -var}) {
+        size_t level = worker.trail.levelStart.size();
+        newDecisionLevel(worker.trail);
+        worker.path.push_back(lit);
+        if (enqueue(worker.assignment, worker.trail, lit) &&
+            unitPropagation(worker.wf, worker.assignment, worker.trail, worker.stats.propagations)) {
+            split(worker, depth - 1, cubes);
+        }
+        worker.path.pop_back();
+        backtrack(worker.trail, worker.assignment, level);
+    }
+}
+
+// Cube and conquer: a lookahead splitter cuts the problem into a few cubes per thread, which are
+// dealt out round-robin and conquered by DPLL on a work-stealing pool. progress is the interval of
+// the per-worker progress lines in seconds, 0 for none.
+bool cubeAndConquer(const Formula& formula, unsigned threads, double progress, Assignment& model) {
+    SharedState shared(threads);
+    std::vector<int> freq(formula.numVars + 1, 0);
+    for (Literal lit : formula.literals) freq[std::abs(lit)]++;
+    for (int var = 1; var <= formula.numVars; ++var) {
+        if (freq[var] > 0) shared.order.push_back(var);
+    }
+    std::stable_sort(shared.order.begin(), shared.order.end(), [&](int a, int b) { return freq[a] > freq[b]; });
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (unsigned i = 0; i < threads; ++i) workers.push_back(std::make_unique<Worker>(formula, i, shared));
+    if (workers[0]->rootConflict) {
+        std::cout << "Unsatisfiable" << std::endl;
+        return false;
+    }
+
+    int depth = 2;
+    while ((1u << (depth - 2)) < threads) depth++;
+    std::vector<Cube> cubes;
+    split(*workers[0], depth, cubes);
+    shared.pending = static_cast<long long>(cubes.size());
+    for (size_t i = 0; i < cubes.size(); ++i) shared.queues[i % threads].push(std::move(cubes[i]));
+
+    StatsMonitor monitor(progress);
+    for (unsigned i = 0; i < threads; ++i) monitor.watch("worker " + std::to_string(i), workers[i]->stats);
+    monitor.start();
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; ++i) pool.emplace_back([&, i]() { workers[i]->run(); });
+    for (std::thread& thread : pool) thread.join();
+    monitor.stop();
+
+    long long decisions = 0, propagations = 0;
+    for (const auto& worker : workers) {
+        decisions += worker->stats.decisions;
+        propagations += worker->stats.propagations;
+    }
+    std::cout << (shared.satisfiable ? "Satisfiable" : "Unsatisfiable") << std::endl;
+    std::cout << "Cubes: " << cubes.size() << std::endl;
+    std::cout << "Donated Subtrees: " << shared.donations << std::endl;
+    std::cout << "Steals: " << shared.steals << std::endl;
+    std::cout << "Decision Steps: " << decisions << std::endl;
+    std::cout << "Propagation Steps: " << propagations << std::endl;
+    if (shared.satisfiable) model = shared.model;
+    return shared.satisfiable;
+}
+
+int main(int argc, char* argv[]) {
+    // Input: DIMACS CNF, or one clause per line (e.g. "1 2" for (x1 v x2)), from a file or stdin;
+    // --threads sets the size of the worker pool (default: one per core);
+    // --progress SECONDS prints per-worker statistics to stderr, as does SIGUSR1
+    SolverOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+    Frontend frontend(options);
+    Formula formula;
+    if (!frontend.load(formula)) return 1;
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Assignment assignment;
+    bool satisfiable = cubeAndConquer(formula, threads, options.progress, assignment);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    if (satisfiable) {
+        frontend.extendModel(assignment);
+        printAssignment(assignment);
+    }
+    std::cout << "Threads: " << threads << std::endl;
+    std::cout << "Solving time: " << elapsed_seconds.count() << "s" << std::endl;
+    frontend.printStats();
+    return 0;
+}
@@ -0,0 +1,13 @@
+#include "../Core/frontend.h"
+
+int main(int argc, char* argv[]) {
+    // DPLL branching by VSIDS activity
+    // Options: see parseOptions in Core/options.h
+    SolverOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+    SolverConfig config;
+    if (!applyOptions(options, config)) return 1;
+    config.algorithm = Algorithm::DPLL;
+    config.heuristic = Heuristic::VSIDS;
+    return solveAndReport(options, config);
+}
@@ -0,0 +1,12 @@
+#include "../Core/frontend.h"
+
+int main(int argc, char* argv[]) {
+    // Stochastic local search, which reports Unknown when its budget runs out
+    // Options: see parseOptions in Core/options.h
+    SolverOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+    SolverConfig config;
+    if (!applyOptions(options, config)) return 1;
+    config.algorithm = Algorithm::LocalSearch;
+    return solveAndReport(options, config);
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include "../Core/frontend.h"
+#include "../Core/solver.h"
+
+// Runs one DPLL solver per thread over the same read-only formula: the first three use the
+// heuristics of the single-strategy solvers, the rest random orders with distinct seeds. The first
+// solver to finish wins and raises stop, which the others check at every search node. progress is
+// the interval of the per-solver progress lines in seconds, 0 for none.
+bool runPortfolio(const ClauseArena& formula, unsigned threads, unsigned seed, double progress, Assignment& model) {
+    std::atomic<bool> stop(false);
+    std::mutex resultMutex;
+    int winner = -1;
+    bool satisfiable = false;
+    std::vector<std::unique_ptr<Solver>> solvers;
+    std::vector<Heuristic> heuristics;
+    const Heuristic fixed[] = {Heuristic::First, Heuristic::Static, Heuristic::Dynamic};
+    for (unsigned i = 0; i < threads; ++i) {
+        SolverConfig config;
+        config.heuristic = i < 3 ? fixed[i] : Heuristic::Random;
+        config.seed = seed + i;
+        heuristics.push_back(config.heuristic);
+        solvers.push_back(makeDpllSolver(config));
+        solvers[i]->setStop(&stop);
+    }
+    StatsMonitor monitor(progress);
+    for (unsigned i = 0; i < threads; ++i) {
+        monitor.watch(std::string(heuristicName(heuristics[i])) + " " + std::to_string(seed + i), solvers[i]->stats());
+    }
+    monitor.start();
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; ++i) {
+        pool.emplace_back([&, i]() {
+            SolveResult result = solvers[i]->solve(formula);
+            if (result == SolveResult::Unknown) return;
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (winner >= 0) return;
+            winner = static_cast<int>(i);
+            satisfiable = result == SolveResult::Satisfiable;
+            stop.store(true, std::memory_order_relaxed);
+        });
+    }
+    for (std::thread& thread : pool) thread.join();
+    monitor.stop();
+
+    // No solver came back with an answer
+    if (winner < 0) {
+        std::cout << "Unknown" << std::endl;
+        return false;
+    }
+    const Solver& best = *solvers[winner];
+    if (satisfiable) model = best.model();
+    std::cout << (satisfiable ? "Satisfiable" : "Unsatisfiable") << std::endl;
+    std::cout << "Winner: " << heuristicName(heuristics[winner]) << " (seed " << seed + winner << ")" << std::endl;
+    std::cout << "Decision Steps: " << best.stats().decisions << std::endl;
+    std::cout << "Propagation Steps: " << best.stats().propagations << std::endl;
+    return satisfiable;
+}
+
+int main(int argc, char* argv[]) {
+    // Input: DIMACS CNF, or one clause per line (e.g. "1 2" for (x1 v x2)), from a file or stdin;
+    // --threads sets the number of workers (default: one per core) and --seed the first random seed;
+    // --progress SECONDS prints per-solver statistics to stderr, as does SIGUSR1
+    SolverOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+    Frontend frontend(options);
+    ClauseArena formula;
+    if (!frontend.load(formula)) return 1;
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Assignment assignment;
+    bool satisfiable = runPortfolio(formula, threads, options.seed, options.progress, assignment);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    if (satisfiable) {
+        frontend.extendModel(assignment);
+        printAssignment(assignment);
+    }
+    std::cout << "Threads: " << threads << std::endl;
+    std::cout << "Solving time: " << elapsed_seconds.count() << "s" << std::endl;
+    frontend.printStats();
+    return 0;
+}
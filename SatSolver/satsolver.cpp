@@ -0,0 +1,91 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include "../Core/frontend.h"
+#include "../Core/solver.h"
+#include "../Core/batch.h"
+
+int main(int argc, char* argv[]) {
+    // Input: DIMACS CNF, or one clause per line (e.g. "1 2" for (x1 v x2)), from a file or stdin;
+    // --algorithm picks resolution, dp, dpll (default) or cdcl, and --heuristic the DPLL branching
+    // rule: first (default), static, jw, moms, dynamic, vsids or random (seeded from --seed). --assume "1 -3"
+    // solves under those literals with the incremental CDCL solver and reports the failed ones.
+    // --restarts luby|geometric|lbd adds restarts with phase saving to DPLL and CDCL.
+    // --learned-memory MB caps the memory CDCL's learned clauses may take.
+    // --algorithm local runs probSAT (or --walk walksat) with --noise, --flips and --time-limit, and
+    // reports Unknown when the budget runs out; --warm-start seeds DPLL and CDCL phases from it.
+    // --progress SECONDS prints the search statistics to stderr every so often, and SIGUSR1 prints
+    // them at once; --timers adds the parsing and preprocessing times. --batch solves every formula
+    // of the input, a stream of them or a directory of files, on --threads workers and prints one
+    // JSON line per formula.
+    SolverOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+    SolverConfig config;
+    if (!applyOptions(options, config)) return 1;
+    if (options.batch) {
+        if (options.assume) {
+            std::cerr << "--assume cannot be combined with --batch" << std::endl;
+            return 1;
+        }
+        return runBatch(options, config);
+    }
+    std::vector<Literal> assumptions;
+    if (options.assume) {
+        if (config.algorithm != Algorithm::CDCL || options.preprocess || options.eliminate || options.probe || options.symmetry) {
+            std::cerr << "--assume needs --algorithm cdcl and no preprocessing" << std::endl;
+            return 1;
+        }
+        char* end = nullptr;
+        for (const char* p = options.assume;; p = end) {
+            long lit = std::strtol(p, &end, 10);
+            if (end == p) break;
+            if (lit != 0) assumptions.push_back(static_cast<Literal>(lit));
+        }
+    }
+    Frontend frontend(options);
+    ClauseArena formula;
+    if (!frontend.load(formula)) return 1;
+    std::unique_ptr<Solver> solver;
+    std::unique_ptr<IncrementalSolver> incremental;
+    if (options.assume) {
+        incremental = makeIncrementalSolver(config);
+        Clause clause;
+        for (ClauseView view : formula) {
+            clause.assign(view.begin(), view.end());
+            incremental->addClause(clause);
+        }
+    } else {
+        solver = makeSolver(config);
+    }
+    const Solver& used = incremental ? *incremental : *solver;
+    StatsMonitor monitor(options.progress);
+    monitor.watch(algorithmName(config.algorithm), used.stats());
+    monitor.start();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    SolveResult result = incremental ? incremental->solve(assumptions) : solver->solve(formula);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    monitor.stop();
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    std::cout << resultName(result) << std::endl;
+    if (result == SolveResult::Satisfiable && used.hasModel()) {
+        Assignment assignment = used.model();
+        frontend.extendModel(assignment);
+        printAssignment(assignment);
+    }
+    if (result == SolveResult::Unsatisfiable && incremental) {
+        std::cout << "Failed Assumptions:";
+        for (Literal lit : incremental->failedAssumptions()) std::cout << " " << lit;
+        std::cout << std::endl;
+    }
+    std::cout << "Algorithm: " << algorithmName(config.algorithm);
+    if (config.algorithm == Algorithm::DPLL) std::cout << " (" << heuristicName(config.heuristic) << ")";
+    std::cout << std::endl;
+    printSolverStats(used.stats(), config);
+    std::cout << "Solving time: " << elapsed_seconds.count() << "s" << std::endl;
+    frontend.printStats();
+    return 0;
+}